@@ -0,0 +1,201 @@
+#include "bench.h"
+#include "board.h"
+#include "evaluate.h"
+#include "nnue.h"
+#include "search.h"
+#include <chrono>
+#include <iomanip>
+
+using namespace std;
+
+void runCellBench(const vector<vector<char>> &config, int plies, ostream &out) {
+    Board board;
+    board.init(config);
+
+    unsigned seed = 12345; // fixed, so every run replays the same games
+    int games = 1;
+    long notifications = 0;
+    chrono::steady_clock::duration elapsed{};
+    for(int ply = 0; ply < plies; ++ply) {
+        const BitPosition &pos = board.getBitPosition();
+        MoveList moves;
+        pos.generateLegalMoves(moves);
+        if(moves.empty() || pos.getHalfmoveClock() >= 100) {
+            board.init(config);
+            ++games;
+            --ply;
+            continue;
+        }
+
+        seed = seed * 1103515245 + 12345;
+        Move mv = pos.unpack(moves[(seed >> 16) % moves.size()]);
+        // A move as the game plays it: the move, then both sides' legal move lists
+        long before = board.getNotificationCount();
+        auto start = chrono::steady_clock::now();
+        board.movePiece(mv);
+        board.getWhiteMoveList();
+        board.getBlackMoveList();
+        elapsed += chrono::steady_clock::now() - start;
+        notifications += board.getNotificationCount() - before;
+    }
+
+    double perMove = plies > 0 ? 1.0 / plies : 0;
+    out << "Moves: " << plies << " in " << games << " games" << endl;
+    out << "Notifications: " << notifications * perMove << " per move" << endl;
+    out << "Time: " << chrono::duration<double, micro>(elapsed).count() * perMove << " us/move" << endl;
+}
+
+// Openings, middlegames and endgames, including the perft suite's tactical positions
+static const char *const BENCH_FENS[] = {
+    "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+    "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+    "r1bqkbnr/pppp1ppp/2n5/4p3/4P3/5N2/PPPP1PPP/RNBQKB1R w KQkq - 2 3",
+    "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10",
+    "r1bq1rk1/pp2bppp/2n2n2/3p4/3P4/2NB1N2/PP3PPP/R1BQ1RK1 w - - 0 10",
+    "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+    "4k3/8/8/8/8/8/4P3/4K3 w - - 0 1",
+    "6k1/5ppp/8/8/8/8/5PPP/3R2K1 w - - 0 1",
+};
+
+void runSearchBench(Search &search, int depth, ostream &out) {
+    SearchLimits saved = search.getLimits();
+    SearchLimits limits;
+    limits.depth = depth;
+    limits.moveTimeMs = 0;
+    search.setLimits(limits);
+
+    uint64_t totalNodes = 0, cutoffs = 0, firstMoveCutoffs = 0, pawnProbes = 0, pawnHits = 0;
+    double totalSeconds = 0;
+    vector<IterationStats> perDepth(depth + 1); // summed over the positions
+    PruningStats pruning;
+    for (const char *fen : BENCH_FENS) {
+        BitPosition pos;
+        pos.setFromFEN(fen);
+        search.clear();
+        SearchResult result = search.think(pos, {});
+        totalNodes += result.nodes;
+        totalSeconds += result.seconds;
+        cutoffs += result.cutoffs;
+        firstMoveCutoffs += result.firstMoveCutoffs;
+        pruning += result.pruning;
+        pawnProbes += result.pawnProbes;
+        pawnHits += result.pawnHits;
+        for (const IterationStats &it : result.iterations) {
+            perDepth[it.depth].depth = it.depth;
+            perDepth[it.depth].nodes += it.nodes;
+            perDepth[it.depth].aspirationResearches += it.aspirationResearches;
+            perDepth[it.depth].pvsResearches += it.pvsResearches;
+        }
+        out << fen << ": depth " << result.depth << " best " << result.best << " score " << result.score
+            << " nodes " << result.nodes << " time " << static_cast<int>(result.seconds * 1000) << " ms" << endl;
+    }
+    search.setLimits(saved);
+
+    out << "Depth  Nodes (main thread)  Aspiration re-searches  PVS re-searches" << endl;
+    for (const IterationStats &it : perDepth) {
+        if (it.depth == 0) continue;
+        out << setw(5) << it.depth << setw(21) << it.nodes << setw(24) << it.aspirationResearches
+            << setw(17) << it.pvsResearches << endl;
+    }
+    out << "Features: " << search.getFeatures().describe() << endl;
+    out << "Threads: " << search.getThreads() << "  Depth: " << depth
+        << "  Nodes: " << totalNodes << "  Time: " << static_cast<int>(totalSeconds * 1000) << " ms"
+        << "  NPS: " << (totalSeconds > 0 ? static_cast<uint64_t>(totalNodes / totalSeconds) : 0) << endl;
+    out << "Cutoffs: " << cutoffs << "  On first move: "
+        << (cutoffs ? 100.0 * firstMoveCutoffs / cutoffs : 0) << "%" << endl;
+    out << "Null move: " << pruning.nullMoveCutoffs << "/" << pruning.nullMoveTries << " cutoffs, "
+        << pruning.nullMoveVerifyFails << " failed verification" << endl;
+    out << "LMR: " << pruning.lmrReductions << " reductions, " << pruning.lmrResearches << " re-searched" << endl;
+    out << "Reverse futility: " << pruning.rfpCutoffs << "  Futility: " << pruning.futilityPrunes
+        << "  Late move pruning: " << pruning.lmpPrunes << endl;
+    out << "Pawn table: " << pawnProbes << " probes, "
+        << (pawnProbes ? 100.0 * pawnHits / pawnProbes : 0) << "% hits" << endl;
+}
+
+// Every node of a small tree below each bench position, walked several times
+const int EVAL_BENCH_DEPTH = 3;
+const int EVAL_BENCH_ROUNDS = 10;
+
+static PawnTable benchPawns;
+static NnueStack benchNnue{EVAL_BENCH_DEPTH + 1};
+
+static int benchClassical(const BitPosition &pos, int) {
+    return evaluateClassical(pos, benchPawns);
+}
+
+static int benchNetwork(const BitPosition &pos, int ply) {
+    return benchNnue.evaluate(pos, ply);
+}
+
+// Plays every line to depth plies and takes them back, evaluating each node when eval is set.
+// Moves are recorded on the network stack as the search does it, while a network is loaded.
+static uint64_t evalWalk(BitPosition &pos, int ply, int depth, int (*eval)(const BitPosition &, int), int64_t &checksum) {
+    if (eval) checksum += eval(pos, ply);
+    if (depth == 0) return 1;
+    MoveList moves;
+    pos.generateLegalMoves(moves);
+    uint64_t nodes = 1;
+    UndoInfo undo;
+    for (PackedMove mv : moves) {
+        if (nnueVersion) benchNnue.recordMove(ply + 1, pos, mv);
+        pos.makeMove(mv, undo);
+        nodes += evalWalk(pos, ply + 1, depth - 1, eval, checksum);
+        pos.unmakeMove(mv, undo);
+    }
+    return nodes;
+}
+
+// Seconds for all rounds of the walk, the best of a few tries since the classical evaluation
+// costs little more than the timing noise
+static double timeEvalWalks(int (*eval)(const BitPosition &, int), uint64_t &nodes, int64_t &checksum) {
+    double best = 0;
+    for (int attempt = 0; attempt < 3; ++attempt) {
+        auto start = chrono::steady_clock::now();
+        nodes = 0;
+        checksum = 0;
+        for (int round = 0; round < EVAL_BENCH_ROUNDS; ++round) {
+            for (const char *fen : BENCH_FENS) {
+                BitPosition pos;
+                pos.setFromFEN(fen);
+                benchNnue.reset();
+                nodes += evalWalk(pos, 0, EVAL_BENCH_DEPTH, eval, checksum);
+            }
+        }
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        if (attempt == 0 || seconds < best) best = seconds;
+    }
+    return best;
+}
+
+static void reportEval(const string &name, double seconds, double baseline, uint64_t nodes, int64_t checksum, ostream &out) {
+    double ns = max(0.0, seconds - baseline) * 1e9 / nodes;
+    out << left << setw(16) << name << right << setw(8) << fixed << setprecision(1) << ns << " ns/eval  "
+        << setw(12) << (ns > 0 ? static_cast<uint64_t>(1e9 / ns) : 0) << " evals/s  checksum " << checksum << endl;
+}
+
+void runEvalBench(const string &networkPath, ostream &out) {
+    uint64_t nodes;
+    int64_t checksum;
+    unloadNetwork();
+    double baseline = timeEvalWalks(nullptr, nodes, checksum);
+    out << "Tree: " << nodes << " nodes (" << EVAL_BENCH_ROUNDS << " rounds to depth " << EVAL_BENCH_DEPTH
+        << ")  Move generation and make/unmake: " << fixed << setprecision(1) << baseline * 1e9 / nodes << " ns/node" << endl;
+    double seconds = timeEvalWalks(benchClassical, nodes, checksum);
+    reportEval("classical", seconds, baseline, nodes, checksum, out);
+
+    string error;
+    if (!loadNetwork(networkPath, error)) {
+        out << "No network: " << error << endl;
+        return;
+    }
+    SimdLevel best = detectSimd();
+    for (SimdLevel level : {SimdLevel::SCALAR, SimdLevel::SSE41, SimdLevel::AVX2}) {
+        if (level > best) break;
+        setSimdLevel(level);
+        // Compared with the walk without a network, so this includes the accumulator updates
+        seconds = timeEvalWalks(benchNetwork, nodes, checksum);
+        reportEval(string("nnue ") + simdName(level), seconds, baseline, nodes, checksum, out);
+    }
+    setSimdLevel(best);
+    unloadNetwork();
+}
@@ -0,0 +1,25 @@
+#ifndef BENCH_H
+#define BENCH_H
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Plays a fixed pseudo-random sequence of legal moves through Board::movePiece, with the text
+// display attached, and reports the notifications each move sends and the time per move,
+// including both sides' move lists.
+// Games start from config and restart from it after mate, stalemate or the fifty-move rule.
+void runCellBench(const std::vector<std::vector<char>> &config, int plies, std::ostream &out);
+
+class Search;
+
+// Searches a fixed set of positions to the given depth with the search's current threads and
+// hash size, clearing what it learned before each, and reports time to depth, nodes and nodes per second
+void runSearchBench(Search &search, int depth, std::ostream &out);
+
+// Evaluates every node of a small tree below each bench position, first with the hand-crafted
+// evaluation and then with the network at networkPath on each vector kernel this CPU supports,
+// and reports the cost of an evaluation beyond the move generation around it. Leaves no network
+// loaded.
+void runEvalBench(const std::string &networkPath, std::ostream &out);
+
+#endif
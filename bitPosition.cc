@@ -0,0 +1,618 @@
+#include "bitPosition.h"
+#include "pieceSquareTables.h"
+#include <cctype>
+#include <cstdlib>
+#include <string_view>
+
+using namespace std;
+
+// Squares that matter for castling
+const int SQ_A1 = 0, SQ_B1 = 1, SQ_C1 = 2, SQ_D1 = 3, SQ_E1 = 4, SQ_F1 = 5, SQ_G1 = 6, SQ_H1 = 7;
+const int SQ_A8 = 56, SQ_C8 = 58, SQ_D8 = 59, SQ_E8 = 60, SQ_F8 = 61, SQ_G8 = 62, SQ_H8 = 63;
+
+// Rights that survive a piece moving from or to each square
+static int castlingMask(int sq) {
+    switch (sq) {
+        case SQ_A1: return ALL_CASTLING & ~WHITE_OOO;
+        case SQ_E1: return ALL_CASTLING & ~(WHITE_OO | WHITE_OOO);
+        case SQ_H1: return ALL_CASTLING & ~WHITE_OO;
+        case SQ_A8: return ALL_CASTLING & ~BLACK_OOO;
+        case SQ_E8: return ALL_CASTLING & ~(BLACK_OO | BLACK_OOO);
+        case SQ_H8: return ALL_CASTLING & ~BLACK_OO;
+        default:    return ALL_CASTLING;
+    }
+}
+
+static PieceType pieceTypeOf(char ch) {
+    switch (tolower(ch)) {
+        case 'k': return PieceType::KING;
+        case 'q': return PieceType::QUEEN;
+        case 'b': return PieceType::BISHOP;
+        case 'r': return PieceType::ROOK;
+        case 'n': return PieceType::KNIGHT;
+        case 'p': return PieceType::PAWN;
+        default:  return PieceType::NONE;
+    }
+}
+
+BitPosition::BitPosition() {
+    clear();
+}
+
+void BitPosition::clear() {
+    for (int c = 0; c < 2; ++c) {
+        for (int pt = 0; pt < 6; ++pt) pieces[c][pt] = 0;
+        occupancy[c] = 0;
+    }
+    occupied = 0;
+    for (int sq = 0; sq < NUM_SQUARES; ++sq) mailbox[sq] = NO_PIECE;
+    sideToMove = Colour::WHITE;
+    castlingRights = NO_CASTLING;
+    epSquare = NO_SQUARE;
+    halfmoveClock = 0;
+    fullmoveNumber = 1;
+    key = zobrist.castling[NO_CASTLING];
+    pawnKey = 0;
+    midgameScore = 0;
+    endgameScore = 0;
+    phase = 0;
+}
+
+void BitPosition::setFromConfig(const vector<vector<char>> &config, Colour turn) {
+    clear();
+    for (int i = 0; i < 8; ++i) {
+        for (int j = 0; j < 8; ++j) {
+            char ch = config[i][j];
+            PieceType pt = pieceTypeOf(ch);
+            if (pt != PieceType::NONE)
+                putPiece(makeSquare(i, j), isupper(ch) ? Colour::WHITE : Colour::BLACK, pt);
+        }
+    }
+    sideToMove = turn;
+
+    castlingRights = homeCastlingRights(); // the config carries no history
+    key = computeKey();
+}
+
+// Rights a king and rook on their home squares could still have
+int BitPosition::homeCastlingRights() const {
+    auto isPiece = [this](int sq, Colour colour, PieceType pt) {
+        return (getPieces(colour, pt) & squareBB(sq)) != 0;
+    };
+    int rights = NO_CASTLING;
+    if (isPiece(SQ_E1, Colour::WHITE, PieceType::KING)) {
+        if (isPiece(SQ_H1, Colour::WHITE, PieceType::ROOK)) rights |= WHITE_OO;
+        if (isPiece(SQ_A1, Colour::WHITE, PieceType::ROOK)) rights |= WHITE_OOO;
+    }
+    if (isPiece(SQ_E8, Colour::BLACK, PieceType::KING)) {
+        if (isPiece(SQ_H8, Colour::BLACK, PieceType::ROOK)) rights |= BLACK_OO;
+        if (isPiece(SQ_A8, Colour::BLACK, PieceType::ROOK)) rights |= BLACK_OOO;
+    }
+    return rights;
+}
+
+// Splits off the next space separated field of a FEN, without copying
+static string_view nextField(string_view &rest) {
+    size_t start = rest.find_first_not_of(' ');
+    if (start == string_view::npos) {
+        rest = {};
+        return {};
+    }
+    rest.remove_prefix(start);
+    size_t end = min(rest.find(' '), rest.size());
+    string_view field = rest.substr(0, end);
+    rest.remove_prefix(end);
+    return field;
+}
+
+// A move clock field; missing or malformed clocks fall back to def
+static int parseClock(string_view field, int def) {
+    if (field.empty() || field.size() > 4) return def;
+    int value = 0;
+    for (char ch : field) {
+        if (!isdigit(static_cast<unsigned char>(ch))) return def;
+        value = value * 10 + (ch - '0');
+    }
+    return value;
+}
+
+bool BitPosition::setFromFEN(string_view fen) {
+    clear();
+    string_view placement = nextField(fen);
+    string_view side = nextField(fen);
+    string_view castling = nextField(fen);
+    string_view ep = nextField(fen);
+    halfmoveClock = parseClock(nextField(fen), 0); // the clocks are optional
+    fullmoveNumber = max(parseClock(nextField(fen), 1), 1);
+
+    // Placement runs from a8 to h1, rank by rank
+    int rank = 7, file = 0;
+    for (char ch : placement) {
+        if (ch == '/') {
+            if (file != 8) break;
+            --rank;
+            file = 0;
+        } else if (ch >= '1' && ch <= '8') {
+            file += ch - '0';
+        } else if (pieceTypeOf(ch) != PieceType::NONE && file < 8 && rank >= 0) {
+            putPiece(makeSquare(rank, file++), isupper(ch) ? Colour::WHITE : Colour::BLACK, pieceTypeOf(ch));
+        } else {
+            file = 9; // unknown character or overflowing rank
+            break;
+        }
+    }
+    if (rank != 0 || file != 8 || (side != "w" && side != "b")
+        || popCount(getPieces(Colour::WHITE, PieceType::KING)) != 1
+        || popCount(getPieces(Colour::BLACK, PieceType::KING)) != 1) {
+        clear();
+        return false;
+    }
+    sideToMove = (side == "w") ? Colour::WHITE : Colour::BLACK;
+
+    for (char ch : castling) {
+        switch (ch) {
+            case 'K': castlingRights |= WHITE_OO; break;
+            case 'Q': castlingRights |= WHITE_OOO; break;
+            case 'k': castlingRights |= BLACK_OO; break;
+            case 'q': castlingRights |= BLACK_OOO; break;
+        }
+    }
+    castlingRights &= homeCastlingRights(); // a right without its king and rook could never be used
+
+    // Keep the en passant square only if a pawn can really capture there, as makeMove does
+    if (ep.size() == 2 && ep[0] >= 'a' && ep[0] <= 'h' && (ep[1] == '3' || ep[1] == '6')) {
+        int sq = makeSquare(ep[1] - '1', ep[0] - 'a');
+        if (pawnAttacks[colourIndex(opposite(sideToMove))][sq] & getPieces(sideToMove, PieceType::PAWN))
+            epSquare = sq;
+    }
+
+    key = computeKey();
+    return true;
+}
+
+string BitPosition::toFEN() const {
+    static const char PIECE_CHARS[] = "KQBRNPkqbrnp"; // indexed by mailbox code
+    string fen;
+    fen.reserve(90);
+    for (int rank = 7; rank >= 0; --rank) {
+        int empty = 0;
+        for (int file = 0; file < 8; ++file) {
+            int sq = makeSquare(rank, file);
+            if (mailbox[sq] == NO_PIECE) {
+                ++empty;
+                continue;
+            }
+            if (empty) fen += char('0' + empty);
+            empty = 0;
+            fen += PIECE_CHARS[mailbox[sq]];
+        }
+        if (empty) fen += char('0' + empty);
+        if (rank) fen += '/';
+    }
+
+    fen += sideToMove == Colour::WHITE ? " w " : " b ";
+    if (castlingRights == NO_CASTLING) fen += '-';
+    if (castlingRights & WHITE_OO) fen += 'K';
+    if (castlingRights & WHITE_OOO) fen += 'Q';
+    if (castlingRights & BLACK_OO) fen += 'k';
+    if (castlingRights & BLACK_OOO) fen += 'q';
+
+    fen += ' ';
+    if (epSquare == NO_SQUARE) {
+        fen += '-';
+    } else {
+        fen += char('a' + fileOf(epSquare));
+        fen += char('1' + rankOf(epSquare));
+    }
+    fen += ' ' + to_string(halfmoveClock) + ' ' + to_string(fullmoveNumber);
+    return fen;
+}
+
+Key BitPosition::computeKey() const {
+    Key k = zobrist.castling[castlingRights];
+    for (Bitboard b = occupied; b; ) {
+        int sq = popLsb(b);
+        k ^= zobrist.pieces[mailbox[sq] / 6][mailbox[sq] % 6][sq];
+    }
+    if (epSquare != NO_SQUARE) k ^= zobrist.epFile[fileOf(epSquare)];
+    if (sideToMove == Colour::BLACK) k ^= zobrist.sideToMove;
+    return k;
+}
+
+void BitPosition::putPiece(int sq, Colour colour, PieceType pt) {
+    Bitboard b = squareBB(sq);
+    int c = colourIndex(colour);
+    pieces[c][pieceIndex(pt)] |= b;
+    occupancy[c] |= b;
+    occupied |= b;
+    mailbox[sq] = c * 6 + pieceIndex(pt);
+    key ^= zobrist.pieces[c][pieceIndex(pt)][sq];
+    if (pt == PieceType::PAWN) pawnKey ^= zobrist.pieces[c][pieceIndex(pt)][sq];
+    midgameScore += pieceSquareTables.midgame[c][pieceIndex(pt)][sq];
+    endgameScore += pieceSquareTables.endgame[c][pieceIndex(pt)][sq];
+    phase += PHASE_WEIGHTS[pieceIndex(pt)];
+}
+
+void BitPosition::removePiece(int sq) {
+    if (mailbox[sq] == NO_PIECE) return;
+    Bitboard b = squareBB(sq);
+    int c = mailbox[sq] / 6;
+    int pt = mailbox[sq] % 6;
+    pieces[c][pt] &= ~b;
+    occupancy[c] &= ~b;
+    occupied &= ~b;
+    key ^= zobrist.pieces[c][pt][sq];
+    if (pt == pieceIndex(PieceType::PAWN)) pawnKey ^= zobrist.pieces[c][pt][sq];
+    midgameScore -= pieceSquareTables.midgame[c][pt][sq];
+    endgameScore -= pieceSquareTables.endgame[c][pt][sq];
+    phase -= PHASE_WEIGHTS[pt];
+    mailbox[sq] = NO_PIECE;
+}
+
+PieceType BitPosition::pieceTypeOn(int sq) const {
+    return mailbox[sq] == NO_PIECE ? PieceType::NONE : static_cast<PieceType>(mailbox[sq] % 6);
+}
+
+Colour BitPosition::colourOn(int sq) const {
+    return mailbox[sq] == NO_PIECE ? Colour::NONE : static_cast<Colour>(mailbox[sq] / 6);
+}
+
+void BitPosition::setSideToMove(Colour colour) {
+    if (colour == sideToMove) return;
+    if (epSquare != NO_SQUARE) {
+        key ^= zobrist.epFile[fileOf(epSquare)]; // an en passant square belongs to the other side
+        epSquare = NO_SQUARE;
+    }
+    key ^= zobrist.sideToMove;
+    sideToMove = colour;
+}
+
+void BitPosition::makeMove(PackedMove mv, UndoInfo &undo) {
+    int from = mv.getFrom();
+    int to = mv.getTo();
+    Colour us = sideToMove;
+    Colour them = opposite(us);
+    PieceType pt = pieceTypeOn(from);
+    int push = (us == Colour::WHITE) ? 8 : -8;
+
+    undo.captured = PieceType::NONE;
+    undo.castlingRights = castlingRights;
+    undo.epSquare = epSquare;
+    undo.halfmoveClock = halfmoveClock;
+    undo.key = key;
+
+    if (epSquare != NO_SQUARE) key ^= zobrist.epFile[fileOf(epSquare)];
+    epSquare = NO_SQUARE;
+    ++halfmoveClock;
+
+    if (mv.isCapture()) {
+        int capturedSquare = mv.isEnPassant() ? to - push : to;
+        undo.captured = pieceTypeOn(capturedSquare);
+        removePiece(capturedSquare);
+        halfmoveClock = 0;
+    }
+
+    removePiece(from);
+    putPiece(to, us, mv.isPromotion() ? mv.getPromotion() : pt);
+
+    if (pt == PieceType::PAWN) {
+        halfmoveClock = 0;
+        // Only recorded when an enemy pawn can actually use it
+        if (mv.isDoublePush() && (pawnAttacks[colourIndex(us)][from + push] & getPieces(them, PieceType::PAWN))) {
+            epSquare = from + push;
+            key ^= zobrist.epFile[fileOf(epSquare)];
+        }
+    } else if (mv.isCastle()) {
+        int rookFrom = (mv.getFlags() == PackedMove::KING_CASTLE) ? to + 1 : to - 2;
+        int rookTo = (mv.getFlags() == PackedMove::KING_CASTLE) ? to - 1 : to + 1;
+        removePiece(rookFrom);
+        putPiece(rookTo, us, PieceType::ROOK);
+    }
+
+    key ^= zobrist.castling[castlingRights];
+    castlingRights &= castlingMask(from) & castlingMask(to);
+    key ^= zobrist.castling[castlingRights] ^ zobrist.sideToMove;
+    if (us == Colour::BLACK) ++fullmoveNumber;
+    sideToMove = them;
+}
+
+void BitPosition::unmakeMove(PackedMove mv, const UndoInfo &undo) {
+    int from = mv.getFrom();
+    int to = mv.getTo();
+    Colour us = opposite(sideToMove);
+
+    sideToMove = us;
+    castlingRights = undo.castlingRights;
+    epSquare = undo.epSquare;
+    halfmoveClock = undo.halfmoveClock;
+    if (us == Colour::BLACK) --fullmoveNumber;
+
+    PieceType pt = mv.isPromotion() ? PieceType::PAWN : pieceTypeOn(to);
+    removePiece(to);
+    putPiece(from, us, pt);
+
+    if (mv.isCastle()) {
+        int rookFrom = (mv.getFlags() == PackedMove::KING_CASTLE) ? to + 1 : to - 2;
+        int rookTo = (mv.getFlags() == PackedMove::KING_CASTLE) ? to - 1 : to + 1;
+        removePiece(rookTo);
+        putPiece(rookFrom, us, PieceType::ROOK);
+    } else if (mv.isCapture()) {
+        int capturedSquare = mv.isEnPassant() ? ((us == Colour::WHITE) ? to - 8 : to + 8) : to;
+        putPiece(capturedSquare, opposite(us), undo.captured);
+    }
+    key = undo.key;
+}
+
+void BitPosition::makeNullMove(UndoInfo &undo) {
+    undo.captured = PieceType::NONE;
+    undo.castlingRights = castlingRights;
+    undo.epSquare = epSquare;
+    undo.halfmoveClock = halfmoveClock;
+    undo.key = key;
+
+    if (epSquare != NO_SQUARE) key ^= zobrist.epFile[fileOf(epSquare)];
+    epSquare = NO_SQUARE;
+    halfmoveClock = 0;
+    key ^= zobrist.sideToMove;
+    sideToMove = opposite(sideToMove);
+}
+
+void BitPosition::unmakeNullMove(const UndoInfo &undo) {
+    sideToMove = opposite(sideToMove);
+    epSquare = undo.epSquare;
+    halfmoveClock = undo.halfmoveClock;
+    key = undo.key;
+}
+
+PackedMove BitPosition::pack(const Move &mv) const {
+    int from = squareOf(mv.getFrom());
+    int to = squareOf(mv.getTo());
+    PieceType pt = pieceTypeOn(from);
+    int flags = (pieceTypeOn(to) != PieceType::NONE) ? PackedMove::CAPTURE : PackedMove::QUIET;
+
+    if (pt == PieceType::KING && abs(fileOf(to) - fileOf(from)) == 2) {
+        flags = (to > from) ? PackedMove::KING_CASTLE : PackedMove::QUEEN_CASTLE;
+    } else if (pt == PieceType::PAWN) {
+        if (to == epSquare) {
+            flags = PackedMove::EN_PASSANT;
+        } else if (abs(to - from) == 16) {
+            flags = PackedMove::DOUBLE_PUSH;
+        } else if (rankOf(to) == 0 || rankOf(to) == 7) {
+            // A promotion with no piece named becomes a queen
+            flags |= PackedMove::PROMOTION + PackedMove::promotionCode(mv.getPromotion());
+        }
+    }
+    return PackedMove{from, to, flags};
+}
+
+Move BitPosition::unpack(PackedMove mv) const {
+    // The captured type mirrors what is on the target square, as HumanPlayer reports it
+    return Move{positionOf(mv.getFrom()), positionOf(mv.getTo()), pieceTypeOn(mv.getTo()), mv.getPromotion()};
+}
+
+Bitboard BitPosition::attackersTo(int sq, Bitboard occ) const {
+    const int W = colourIndex(Colour::WHITE), B = colourIndex(Colour::BLACK);
+    Bitboard rooks = pieces[W][pieceIndex(PieceType::ROOK)] | pieces[B][pieceIndex(PieceType::ROOK)]
+                   | pieces[W][pieceIndex(PieceType::QUEEN)] | pieces[B][pieceIndex(PieceType::QUEEN)];
+    Bitboard bishops = pieces[W][pieceIndex(PieceType::BISHOP)] | pieces[B][pieceIndex(PieceType::BISHOP)]
+                     | pieces[W][pieceIndex(PieceType::QUEEN)] | pieces[B][pieceIndex(PieceType::QUEEN)];
+
+    return (pawnAttacks[B][sq] & pieces[W][pieceIndex(PieceType::PAWN)])
+         | (pawnAttacks[W][sq] & pieces[B][pieceIndex(PieceType::PAWN)])
+         | (knightAttacks[sq] & (pieces[W][pieceIndex(PieceType::KNIGHT)] | pieces[B][pieceIndex(PieceType::KNIGHT)]))
+         | (kingAttacks[sq] & (pieces[W][pieceIndex(PieceType::KING)] | pieces[B][pieceIndex(PieceType::KING)]))
+         | (rookAttacks(sq, occ) & rooks)
+         | (bishopAttacks(sq, occ) & bishops);
+}
+
+bool BitPosition::isAttacked(int sq, Colour by) const {
+    return attackersTo(sq, occupied) & getOccupancy(by);
+}
+
+bool BitPosition::hasNonPawnMaterial(Colour colour) const {
+    return getOccupancy(colour) & ~(getPieces(colour, PieceType::PAWN) | getPieces(colour, PieceType::KING));
+}
+
+bool BitPosition::inCheck() const {
+    return isAttacked(kingSquare(sideToMove), opposite(sideToMove));
+}
+
+Bitboard BitPosition::getCheckers() const {
+    return attackersTo(kingSquare(sideToMove), occupied) & getOccupancy(opposite(sideToMove));
+}
+
+// Pieces of colour us that are the only blocker between their king and an enemy slider
+Bitboard BitPosition::pinnedPieces(Colour us) const {
+    Colour them = opposite(us);
+    int ksq = kingSquare(us);
+    Bitboard queens = getPieces(them, PieceType::QUEEN);
+    Bitboard snipers = (rookAttacks(ksq, 0) & (getPieces(them, PieceType::ROOK) | queens))
+                     | (bishopAttacks(ksq, 0) & (getPieces(them, PieceType::BISHOP) | queens));
+
+    Bitboard pinned = 0;
+    while (snipers) {
+        Bitboard blockers = betweenBB(ksq, popLsb(snipers)) & occupied;
+        if (blockers && !moreThanOne(blockers)) pinned |= blockers & getOccupancy(us);
+    }
+    return pinned;
+}
+
+// Only legal moves are emitted: checkers, the squares that answer a check and the pin rays are
+// worked out once up front, so no move has to be played out to see if it exposes the king.
+void BitPosition::generateLegalMoves(MoveList &moves, Bitboard fromMask) const {
+    generate(moves, fromMask, true, true);
+}
+
+void BitPosition::generateLegalCaptures(MoveList &moves) const {
+    generate(moves, ~Bitboard{0}, true, false);
+}
+
+void BitPosition::generateLegalQuiets(MoveList &moves) const {
+    generate(moves, ~Bitboard{0}, false, true);
+}
+
+bool BitPosition::isLegal(PackedMove mv) const {
+    MoveList moves;
+    generate(moves, squareBB(mv.getFrom()), true, true);
+    return moves.contains(mv);
+}
+
+// Legal moves of the pieces on fromMask. Captures and promotions are one half, everything else
+// the other, so the search can generate them in separate stages.
+void BitPosition::generate(MoveList &moves, Bitboard fromMask, bool captures, bool quiets) const {
+    moves.clear();
+    Colour us = sideToMove;
+    Colour them = opposite(us);
+    int ksq = kingSquare(us);
+    Bitboard own = getOccupancy(us);
+    Bitboard enemy = getOccupancy(them);
+    Bitboard empty = ~occupied;
+    Bitboard checkers = getCheckers();
+
+    // King: the destination must be safe with the king lifted off its square, so that it cannot
+    // step backwards along the line of a checking slider
+    Bitboard withoutKing = occupied ^ squareBB(ksq);
+    Bitboard kingTargets = (squareBB(ksq) & fromMask) ? kingAttacks[ksq] & ~own : 0;
+    for (Bitboard t = captures ? kingTargets & enemy : 0; t; ) {
+        int to = popLsb(t);
+        if (!(attackersTo(to, withoutKing) & enemy)) moves.add(ksq, to, PackedMove::CAPTURE);
+    }
+    for (Bitboard t = quiets ? kingTargets & empty : 0; t; ) {
+        int to = popLsb(t);
+        if (!(attackersTo(to, withoutKing) & enemy)) moves.add(ksq, to);
+    }
+
+    // In double check only the king can move
+    if (moreThanOne(checkers)) return;
+
+    // Squares that capture the checker or block its line; every square when not in check
+    // Pinned pieces may only move along the line through their king
+    Bitboard evasion = checkers ? betweenBB(ksq, lsb(checkers)) | checkers : ~Bitboard{0};
+    Bitboard pinned = pinnedPieces(us);
+    auto allowed = [&](int from) {
+        return (squareBB(from) & pinned) ? evasion & lineBB(ksq, from) : evasion;
+    };
+
+    auto addPromotions = [&](int from, int to, int base) {
+        for (int code = 3; code >= 0; --code) moves.add(from, to, base + code);
+    };
+
+    // Pawns: pushes are computed a whole set at a time, then checked against the masks per move
+    Bitboard pawns = getPieces(us, PieceType::PAWN) & fromMask;
+    Bitboard lastRank = (us == Colour::WHITE) ? RANK_8 : RANK_1;
+    int push = (us == Colour::WHITE) ? 8 : -8;
+    Bitboard single = (us == Colour::WHITE) ? shiftNorth(pawns) & empty : shiftSouth(pawns) & empty;
+    Bitboard dbl = (us == Colour::WHITE) ? shiftNorth(single & (RANK_2 << 8)) & empty
+                                         : shiftSouth(single & (RANK_7 >> 8)) & empty;
+    if (!quiets) {
+        single &= lastRank;
+        dbl = 0;
+    }
+    if (!captures) single &= ~lastRank;
+    while (single) {
+        int to = popLsb(single);
+        if (!(allowed(to - push) & squareBB(to))) continue;
+        if (squareBB(to) & lastRank) addPromotions(to - push, to, PackedMove::PROMOTION);
+        else moves.add(to - push, to);
+    }
+    while (dbl) {
+        int to = popLsb(dbl);
+        if (allowed(to - 2 * push) & squareBB(to)) moves.add(to - 2 * push, to, PackedMove::DOUBLE_PUSH);
+    }
+    for (Bitboard b = captures ? pawns : 0; b; ) {
+        int from = popLsb(b);
+        Bitboard targets = pawnAttacks[colourIndex(us)][from] & enemy & allowed(from);
+        while (targets) {
+            int to = popLsb(targets);
+            if (squareBB(to) & lastRank) addPromotions(from, to, PackedMove::PROMOTION_CAPTURE);
+            else moves.add(from, to, PackedMove::CAPTURE);
+        }
+
+        // En passant removes two pawns from one rank, which the pin masks cannot see,
+        // so test the king directly against the occupancy after the capture
+        if (epSquare != NO_SQUARE && (pawnAttacks[colourIndex(us)][from] & squareBB(epSquare))) {
+            int captured = epSquare - push;
+            Bitboard after = (occupied ^ squareBB(from) ^ squareBB(captured)) | squareBB(epSquare);
+            if (!(attackersTo(ksq, after) & enemy & ~squareBB(captured)))
+                moves.add(from, epSquare, PackedMove::EN_PASSANT);
+        }
+    }
+
+    // Pieces
+    for (PieceType pt : {PieceType::KNIGHT, PieceType::BISHOP, PieceType::ROOK, PieceType::QUEEN}) {
+        for (Bitboard b = getPieces(us, pt) & fromMask; b; ) {
+            int from = popLsb(b);
+            Bitboard targets;
+            switch (pt) {
+                case PieceType::KNIGHT: targets = knightAttacks[from]; break;
+                case PieceType::BISHOP: targets = bishopAttacks(from, occupied); break;
+                case PieceType::ROOK:   targets = rookAttacks(from, occupied); break;
+                default:                targets = queenAttacks(from, occupied); break;
+            }
+            targets &= allowed(from);
+            for (Bitboard t = captures ? targets & enemy : 0; t; ) moves.add(from, popLsb(t), PackedMove::CAPTURE);
+            for (Bitboard t = quiets ? targets & empty : 0; t; ) moves.add(from, popLsb(t));
+        }
+    }
+
+    // Castling: path empty, king not in check and not crossing an attacked square
+    int kingOO = (us == Colour::WHITE) ? WHITE_OO : BLACK_OO;
+    int kingOOO = (us == Colour::WHITE) ? WHITE_OOO : BLACK_OOO;
+    int base = (us == Colour::WHITE) ? SQ_A1 : SQ_A8;
+    if (quiets && (castlingRights & (kingOO | kingOOO)) && !checkers && (squareBB(ksq) & fromMask)) {
+        if ((castlingRights & kingOO)
+            && !(occupied & (squareBB(base + SQ_F1) | squareBB(base + SQ_G1)))
+            && !isAttacked(base + SQ_F1, them) && !isAttacked(base + SQ_G1, them)) {
+            moves.add(base + SQ_E1, base + SQ_G1, PackedMove::KING_CASTLE);
+        }
+        if ((castlingRights & kingOOO)
+            && !(occupied & (squareBB(base + SQ_B1) | squareBB(base + SQ_C1) | squareBB(base + SQ_D1)))
+            && !isAttacked(base + SQ_D1, them) && !isAttacked(base + SQ_C1, them)) {
+            moves.add(base + SQ_E1, base + SQ_C1, PackedMove::QUEEN_CASTLE);
+        }
+    }
+}
+
+bool BitPosition::hasLegalMove() const {
+    MoveList moves;
+    generateLegalMoves(moves);
+    return !moves.empty();
+}
+
+bool BitPosition::givesCheck(PackedMove mv) const {
+    Colour us = sideToMove;
+    int ksq = kingSquare(opposite(us));
+    int from = mv.getFrom();
+    int to = mv.getTo();
+    PieceType pt = mv.isPromotion() ? mv.getPromotion() : pieceTypeOn(from);
+    Bitboard occ = (occupied ^ squareBB(from)) | squareBB(to);
+
+    // Direct check from the moved piece
+    Bitboard attacks;
+    switch (pt) {
+        case PieceType::PAWN:   attacks = pawnAttacks[colourIndex(us)][to]; break;
+        case PieceType::KNIGHT: attacks = knightAttacks[to]; break;
+        case PieceType::BISHOP: attacks = bishopAttacks(to, occ); break;
+        case PieceType::ROOK:   attacks = rookAttacks(to, occ); break;
+        case PieceType::QUEEN:  attacks = queenAttacks(to, occ); break;
+        default:                attacks = 0; break;
+    }
+    if (attacks & squareBB(ksq)) return true;
+
+    // Discovered check is only possible if the piece leaves the king's line, or if a second
+    // piece also changes square (castling rook, en passant victim)
+    Bitboard queens = getPieces(us, PieceType::QUEEN);
+    Bitboard rooks = (getPieces(us, PieceType::ROOK) | queens) & ~squareBB(from);
+    Bitboard bishops = (getPieces(us, PieceType::BISHOP) | queens) & ~squareBB(from);
+    if (mv.isCastle()) {
+        int rookFrom = (to > from) ? to + 1 : to - 2;
+        int rookTo = (to > from) ? to - 1 : to + 1;
+        return rookAttacks(rookTo, (occ ^ squareBB(rookFrom)) | squareBB(rookTo)) & squareBB(ksq);
+    }
+    if (mv.isEnPassant()) {
+        occ ^= squareBB(to + (us == Colour::WHITE ? -8 : 8));
+    } else if (!lineBB(ksq, from) || aligned(ksq, from, to)) {
+        return false;
+    }
+    return (rookAttacks(ksq, occ) & rooks) | (bishopAttacks(ksq, occ) & bishops);
+}
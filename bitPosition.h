@@ -0,0 +1,115 @@
+#ifndef BITPOSITION_H
+#define BITPOSITION_H
+#include "bitboard.h"
+#include "enumerated.h"
+#include "move.h"
+#include "packedMove.h"
+#include "moveList.h"
+#include "zobrist.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Castling rights, stored as a 4 bit mask
+const int WHITE_OO = 1;
+const int WHITE_OOO = 2;
+const int BLACK_OO = 4;
+const int BLACK_OOO = 8;
+const int NO_CASTLING = 0;
+const int ALL_CASTLING = WHITE_OO | WHITE_OOO | BLACK_OO | BLACK_OOO;
+
+// Everything makeMove overwrites, so unmakeMove can restore the position without recomputing
+struct UndoInfo {
+    PieceType captured;
+    int castlingRights;
+    int epSquare;
+    int halfmoveClock;
+    Key key;
+};
+
+// Bitboard representation of a chess position: one bitboard per colour and piece type,
+// occupancy masks, and a mailbox for O(1) "what is on this square" queries.
+// Plain data with no observers or heap members, so copies are cheap.
+class BitPosition {
+    Bitboard pieces[2][6];   // indexed by colourIndex, then pieceIndex
+    Bitboard occupancy[2];   // all pieces of one colour
+    Bitboard occupied;       // all pieces
+    std::uint8_t mailbox[NUM_SQUARES]; // piece code per square, NO_PIECE if empty
+    Colour sideToMove;
+    int castlingRights;
+    int epSquare;            // square a pawn can capture onto en passant, NO_SQUARE if none
+    int halfmoveClock;
+    int fullmoveNumber;
+    Key key;                 // Zobrist hash, updated incrementally
+    Key pawnKey;             // the same, over the pawns alone; 0 with no pawns on the board
+    // Evaluation terms from white's point of view, also updated incrementally by putPiece and
+    // removePiece: material plus piece-square values for each stage, and the game phase
+    int midgameScore;
+    int endgameScore;
+    int phase;
+
+    int homeCastlingRights() const;
+    void generate(MoveList &moves, Bitboard fromMask, bool captures, bool quiets) const;
+
+    public:
+    static const std::uint8_t NO_PIECE = 12;
+
+    BitPosition(); // empty board, white to move
+    void clear();
+    void setFromConfig(const std::vector<std::vector<char>> &config, Colour turn);
+    bool setFromFEN(std::string_view fen); // false (and an empty board) if fen is malformed
+    std::string toFEN() const;
+
+    void putPiece(int sq, Colour colour, PieceType pt);
+    void removePiece(int sq);
+    void makeMove(PackedMove mv, UndoInfo &undo);
+    void unmakeMove(PackedMove mv, const UndoInfo &undo);
+    // Passes the turn, for null-move pruning. Not legal in check. The halfmove clock restarts so
+    // repetition checks do not look back past the pass.
+    void makeNullMove(UndoInfo &undo);
+    void unmakeNullMove(const UndoInfo &undo);
+
+    // Conversion between the REPL's Move and PackedMove, using this position to fill in flags
+    PackedMove pack(const Move &mv) const;
+    Move unpack(PackedMove mv) const;
+
+    // Accessors
+    PieceType pieceTypeOn(int sq) const;
+    Colour colourOn(int sq) const;
+    Bitboard getPieces(Colour colour, PieceType pt) const { return pieces[colourIndex(colour)][pieceIndex(pt)]; }
+    Bitboard getOccupancy(Colour colour) const { return occupancy[colourIndex(colour)]; }
+    Bitboard getOccupied() const { return occupied; }
+    int kingSquare(Colour colour) const { return lsb(getPieces(colour, PieceType::KING)); }
+    Colour getSideToMove() const { return sideToMove; }
+    void setSideToMove(Colour colour);
+    int getCastlingRights() const { return castlingRights; }
+    int getEpSquare() const { return epSquare; }
+    int getHalfmoveClock() const { return halfmoveClock; }
+    int getFullmoveNumber() const { return fullmoveNumber; }
+    Key getKey() const { return key; }
+    Key getPawnKey() const { return pawnKey; }
+    Key computeKey() const;  // from scratch; the incremental key must always equal this
+    int getMidgameScore() const { return midgameScore; }
+    int getEndgameScore() const { return endgameScore; }
+    int getPhase() const { return phase; }
+    bool hasNonPawnMaterial(Colour colour) const; // anything besides king and pawns
+
+    // Attack queries
+    Bitboard attackersTo(int sq, Bitboard occ) const;
+    bool isAttacked(int sq, Colour by) const;
+    bool inCheck() const;
+    Bitboard getCheckers() const; // enemy pieces giving check to the side to move
+
+    Bitboard pinnedPieces(Colour us) const;
+
+    // Fills moves with every legal move for the side to move, or only those of the pieces on fromMask
+    void generateLegalMoves(MoveList &moves, Bitboard fromMask = ~Bitboard{0}) const;
+    void generateLegalCaptures(MoveList &moves) const; // captures and promotions only
+    void generateLegalQuiets(MoveList &moves) const;   // everything generateLegalCaptures leaves out
+    bool isLegal(PackedMove mv) const;                 // for moves from elsewhere, such as the hash table
+    bool hasLegalMove() const;
+    bool givesCheck(PackedMove mv) const; // mv must be legal for the side to move
+};
+
+#endif
@@ -0,0 +1,147 @@
+#include "bitboard.h"
+
+using namespace std;
+
+Bitboard knightAttacks[NUM_SQUARES];
+Bitboard kingAttacks[NUM_SQUARES];
+Bitboard pawnAttacks[2][NUM_SQUARES];
+
+int squareOf(const Position &pos) {
+    return makeSquare(pos.getRowVector(), pos.getColVector());
+}
+
+Position positionOf(int sq) {
+    return Position{rankOf(sq), fileOf(sq)};
+}
+
+// Walks from sq in direction (dr, dc) until the edge of the board or the first occupied square
+static Bitboard rayAttacks(int sq, int dr, int dc, Bitboard occupied) {
+    Bitboard attacks = 0;
+    int r = rankOf(sq) + dr;
+    int c = fileOf(sq) + dc;
+    while (r >= 0 && r < 8 && c >= 0 && c < 8) {
+        Bitboard b = squareBB(makeSquare(r, c));
+        attacks |= b;
+        if (occupied & b) break;
+        r += dr;
+        c += dc;
+    }
+    return attacks;
+}
+
+static Bitboard slidingAttacks(int sq, Bitboard occupied, const int dirs[4][2]) {
+    Bitboard attacks = 0;
+    for (int i = 0; i < 4; ++i) attacks |= rayAttacks(sq, dirs[i][0], dirs[i][1], occupied);
+    return attacks;
+}
+
+const int ROOK_DIRS[4][2] = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}};
+const int BISHOP_DIRS[4][2] = {{1, 1}, {1, -1}, {-1, 1}, {-1, -1}};
+
+// Every rook and bishop blocker configuration fits in these (2^12 and 2^9 at most per square)
+const int ROOK_TABLE_SIZE = 0x19000;
+const int BISHOP_TABLE_SIZE = 0x1480;
+
+Magic rookMagics[NUM_SQUARES];
+Magic bishopMagics[NUM_SQUARES];
+static Bitboard rookTable[ROOK_TABLE_SIZE];
+static Bitboard bishopTable[BISHOP_TABLE_SIZE];
+
+// xorshift64* generator; a fixed seed keeps the magics (and startup time) reproducible
+class MagicRng {
+    Bitboard s;
+
+  public:
+    MagicRng(Bitboard seed) : s{seed} {}
+    Bitboard next() {
+        s ^= s >> 12;
+        s ^= s << 25;
+        s ^= s >> 27;
+        return s * 2685821657736338717ULL;
+    }
+    Bitboard sparse() { return next() & next() & next(); } // few bits set make better magics
+};
+
+// Per-rank seeds known to find working magics after few attempts
+const Bitboard MAGIC_SEEDS[8] = {728, 10316, 55013, 32803, 12281, 15100, 16645, 255};
+
+// Fills magics[] and table[] for one slider, following the layout used by most bitboard engines:
+// each square gets a contiguous slice sized 2^(bits in mask)
+static void initMagics(Magic magics[], Bitboard table[], const int dirs[4][2]) {
+    Bitboard occupancies[4096], reference[4096];
+    int epoch[4096] = {}, attempt = 0;
+    Bitboard *next = table;
+
+    for (int sq = 0; sq < NUM_SQUARES; ++sq) {
+        Bitboard edges = ((RANK_1 | RANK_8) & ~(RANK_1 << (8 * rankOf(sq))))
+                       | ((FILE_A | FILE_H) & ~(FILE_A << fileOf(sq)));
+
+        Magic &m = magics[sq];
+        m.mask = slidingAttacks(sq, 0, dirs) & ~edges;
+        m.shift = 64 - popCount(m.mask);
+        m.attacks = next;
+
+        // Enumerate every subset of the mask (Carry-Rippler) with its attack set
+        int size = 0;
+        Bitboard b = 0;
+        do {
+            occupancies[size] = b;
+            reference[size] = slidingAttacks(sq, b, dirs);
+#if defined(__BMI2__)
+            m.attacks[_pext_u64(b, m.mask)] = reference[size];
+#endif
+            ++size;
+            b = (b - m.mask) & m.mask;
+        } while (b);
+        next += size;
+
+#if !defined(__BMI2__)
+        // Try random magics until one maps every subset without a destructive collision
+        MagicRng rng(MAGIC_SEEDS[rankOf(sq)]);
+        for (int i = 0; i < size; ) {
+            do {
+                m.magic = rng.sparse();
+            } while (popCount((m.mask * m.magic) >> 56) < 6);
+
+            ++attempt;
+            for (i = 0; i < size; ++i) {
+                unsigned idx = m.index(occupancies[i]);
+                if (epoch[idx] < attempt) {
+                    epoch[idx] = attempt;
+                    m.attacks[idx] = reference[i];
+                } else if (m.attacks[idx] != reference[i]) {
+                    break;
+                }
+            }
+        }
+#endif
+    }
+}
+
+// Sets the bit for (r, c) if it lies on the board
+static Bitboard onBoard(int r, int c) {
+    return (r >= 0 && r < 8 && c >= 0 && c < 8) ? squareBB(makeSquare(r, c)) : 0;
+}
+
+void initBitboards() {
+    const int knightSteps[8][2] = {{2, 1}, {1, 2}, {-1, 2}, {-2, 1}, {-2, -1}, {-1, -2}, {1, -2}, {2, -1}};
+    const int kingSteps[8][2] = {{1, 0}, {1, 1}, {0, 1}, {-1, 1}, {-1, 0}, {-1, -1}, {0, -1}, {1, -1}};
+
+    for (int sq = 0; sq < NUM_SQUARES; ++sq) {
+        int r = rankOf(sq);
+        int c = fileOf(sq);
+
+        knightAttacks[sq] = 0;
+        kingAttacks[sq] = 0;
+        for (int i = 0; i < 8; ++i) {
+            knightAttacks[sq] |= onBoard(r + knightSteps[i][0], c + knightSteps[i][1]);
+            kingAttacks[sq] |= onBoard(r + kingSteps[i][0], c + kingSteps[i][1]);
+        }
+
+        pawnAttacks[colourIndex(Colour::WHITE)][sq] = onBoard(r + 1, c - 1) | onBoard(r + 1, c + 1);
+        pawnAttacks[colourIndex(Colour::BLACK)][sq] = onBoard(r - 1, c - 1) | onBoard(r - 1, c + 1);
+    }
+
+    initMagics(rookMagics, rookTable, ROOK_DIRS);
+    initMagics(bishopMagics, bishopTable, BISHOP_DIRS);
+}
@@ -0,0 +1,131 @@
+#ifndef BITBOARD_H
+#define BITBOARD_H
+#include "enumerated.h"
+#include "position.h"
+#include <bit>
+#include <cstdint>
+#if defined(__BMI2__)
+#include <immintrin.h>
+#endif
+
+// A set of squares, one bit per square. Squares are numbered a1 = 0, b1 = 1, ..., h8 = 63
+using Bitboard = std::uint64_t;
+
+const int NUM_SQUARES = 64;
+const int NO_SQUARE = -1;
+
+const Bitboard FILE_A = 0x0101010101010101ULL;
+const Bitboard FILE_H = FILE_A << 7;
+const Bitboard RANK_1 = 0xFFULL;
+const Bitboard RANK_2 = RANK_1 << 8;
+const Bitboard RANK_7 = RANK_1 << 48;
+const Bitboard RANK_8 = RANK_1 << 56;
+
+// Square helpers
+inline int makeSquare(int rowVector, int colVector) { return rowVector * 8 + colVector; }
+inline int rankOf(int sq) { return sq >> 3; }
+inline int fileOf(int sq) { return sq & 7; }
+inline Bitboard squareBB(int sq) { return Bitboard{1} << sq; }
+int squareOf(const Position &pos);
+Position positionOf(int sq);
+
+// Bit twiddling
+inline int popCount(Bitboard b) { return std::popcount(b); }
+inline int lsb(Bitboard b) { return std::countr_zero(b); }
+inline int popLsb(Bitboard &b) {
+    int sq = lsb(b);
+    b &= b - 1;
+    return sq;
+}
+inline bool moreThanOne(Bitboard b) { return b & (b - 1); }
+
+// Colour::WHITE and Colour::BLACK double as array indices
+inline int colourIndex(Colour colour) { return static_cast<int>(colour); }
+inline int pieceIndex(PieceType pt) { return static_cast<int>(pt); }
+inline Colour opposite(Colour colour) { return colour == Colour::WHITE ? Colour::BLACK : Colour::WHITE; }
+
+// Shifts that drop bits wrapping around the a/h files
+inline Bitboard shiftNorth(Bitboard b) { return b << 8; }
+inline Bitboard shiftSouth(Bitboard b) { return b >> 8; }
+inline Bitboard shiftEast(Bitboard b) { return (b & ~FILE_H) << 1; }
+inline Bitboard shiftWest(Bitboard b) { return (b & ~FILE_A) >> 1; }
+
+// Line geometry between pairs of squares, generated at compile time:
+// between[a][b] holds the squares strictly between a and b, line[a][b] the whole rank, file or
+// diagonal through both (including a and b). Both are empty when a and b are not aligned.
+struct LineTables {
+    Bitboard between[NUM_SQUARES][NUM_SQUARES];
+    Bitboard line[NUM_SQUARES][NUM_SQUARES];
+};
+
+constexpr LineTables makeLineTables() {
+    LineTables t{};
+    const int dirs[8][2] = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}, {1, 1}, {1, -1}, {-1, 1}, {-1, -1}};
+    for (int a = 0; a < NUM_SQUARES; ++a) {
+        for (const auto &d : dirs) {
+            // Walk away from a; every square reached is aligned with a along this direction
+            Bitboard ray = 0;
+            for (int r = (a >> 3) + d[0], c = (a & 7) + d[1]; r >= 0 && r < 8 && c >= 0 && c < 8; r += d[0], c += d[1]) {
+                ray |= Bitboard{1} << (r * 8 + c);
+            }
+            Bitboard back = 0;
+            for (int r = (a >> 3) - d[0], c = (a & 7) - d[1]; r >= 0 && r < 8 && c >= 0 && c < 8; r -= d[0], c -= d[1]) {
+                back |= Bitboard{1} << (r * 8 + c);
+            }
+            Bitboard gap = 0;
+            for (int r = (a >> 3) + d[0], c = (a & 7) + d[1]; r >= 0 && r < 8 && c >= 0 && c < 8; r += d[0], c += d[1]) {
+                int b = r * 8 + c;
+                t.between[a][b] = gap;
+                t.line[a][b] = ray | back | (Bitboard{1} << a);
+                gap |= Bitboard{1} << b;
+            }
+        }
+    }
+    return t;
+}
+
+inline constexpr LineTables lineTables = makeLineTables();
+
+inline Bitboard betweenBB(int a, int b) { return lineTables.between[a][b]; }
+inline Bitboard lineBB(int a, int b) { return lineTables.line[a][b]; }
+inline bool aligned(int a, int b, int c) { return lineBB(a, b) & squareBB(c); }
+
+// Attack tables, filled by initBitboards()
+extern Bitboard knightAttacks[NUM_SQUARES];
+extern Bitboard kingAttacks[NUM_SQUARES];
+extern Bitboard pawnAttacks[2][NUM_SQUARES];
+
+// Sliding attacks come from precomputed tables indexed by the blockers on the piece's rays.
+// With BMI2 (e.g. -mbmi2 or -march=native) the index is a single PEXT; otherwise it is the
+// classic "fancy magic" multiply and shift, with magics found at startup.
+struct Magic {
+    Bitboard mask;      // relevant blocker squares, board edges excluded
+    Bitboard magic;
+    Bitboard *attacks;  // this square's slice of the shared attack table
+    int shift;
+
+    unsigned index(Bitboard occupied) const {
+#if defined(__BMI2__)
+        return _pext_u64(occupied, mask);
+#else
+        return unsigned(((occupied & mask) * magic) >> shift);
+#endif
+    }
+};
+
+extern Magic rookMagics[NUM_SQUARES];
+extern Magic bishopMagics[NUM_SQUARES];
+
+inline Bitboard rookAttacks(int sq, Bitboard occupied) {
+    return rookMagics[sq].attacks[rookMagics[sq].index(occupied)];
+}
+inline Bitboard bishopAttacks(int sq, Bitboard occupied) {
+    return bishopMagics[sq].attacks[bishopMagics[sq].index(occupied)];
+}
+inline Bitboard queenAttacks(int sq, Bitboard occupied) {
+    return rookAttacks(sq, occupied) | bishopAttacks(sq, occupied);
+}
+
+void initBitboards(); // must be called once before any attack lookup
+
+#endif
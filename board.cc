@@ -5,396 +5,196 @@ using namespace std;
 
 const int GRID_SIZE = 8;
 
-void Board::init(vector<vector<char>> config) {
-    // Clear existing grid and observers (to prevent dangling pointers)
-    // If a grid already exists, we must detach its observers before replacing td/gd
-    for (auto &row : grid) {
-        for (auto &cell : row) {
-            cell.detachAll();
-        }
-    }
+void Board::init(vector<vector<char>> config, bool withDisplay) {
+    bitPosition.setFromConfig(config, bitPosition.getSideToMove());
+    initCells(withDisplay);
+}
 
-    grid.clear();
-    grid.resize(GRID_SIZE, std::vector<Cell>(GRID_SIZE));
+bool Board::fromFEN(string_view fen, bool withDisplay) {
+    BitPosition loaded;
+    if(!loaded.setFromFEN(fen)) return false;
+    bitPosition = loaded;
+    initCells(withDisplay);
+    return true;
+}
 
-    // Create displays
-    td = std::make_unique<TextDisplay>(GRID_SIZE);
+string Board::toFEN() const {
+    return bitPosition.toFEN();
+}
+
+// Rebuilds the cells, display and history around a freshly loaded bitPosition
+void Board::initCells(bool withDisplay) {
+    grid.assign(GRID_SIZE, std::vector<Cell>(GRID_SIZE));
+
+    if(withDisplay) td.emplace(GRID_SIZE);
+    else td.reset();
     //gd = std::make_unique<GraphicsDisplay>(GRID_SIZE);
 
-    //Converting each char to info to use setCell
+    // Mirror the bitboards into the grid and the display
     for(int i = 0; i < GRID_SIZE ;i++) {
         for(int j = 0; j < GRID_SIZE; j++) {
-            char ch = config[i][j];
+            int sq = makeSquare(i, j);
             Position pos{i, j};
-            Colour col;
-            PieceType pt;
-
-            if(ch > 'A' && ch < 'Z')
-                col = Colour::WHITE;
-            else if (ch > 'a' && ch < 'z')
-                col = Colour::BLACK;
-            else 
-                col = Colour::NONE;
-
-            if(ch == 'k'){
-                pt = PieceType::KING;
-                posBKing = pos;
-            } else if(ch == 'K'){
-                pt = PieceType::KING;
-                posWKing = pos;
-            }else if(ch == 'q' || ch == 'Q')
-                pt = PieceType::QUEEN;
-            else if(ch == 'b' || ch == 'B')
-                pt = PieceType::BISHOP;
-            else if(ch == 'n' || ch == 'N')
-                pt = PieceType::KNIGHT;
-            else if(ch == 'r' || ch == 'R')
-                pt = PieceType::ROOK;
-            else if(ch == 'p' || ch == 'P')
-                pt = PieceType::PAWN;
-            else
-                pt = PieceType::NONE;
-
-            Info inf{pos, col, pt};
-            State state = (pt == PieceType::NONE) ? State{StateType::EmptyCell, Colour::NONE, PieceType::NONE, pos, Direction::N}
-                                                : State{StateType::Update, col, pt, pos, Direction::N};
-            grid[pos.getRowVector()][pos.getColVector()].setCell(inf, state);
-            
-            // Attach both displays as observers
-            grid[pos.getRowVector()][pos.getColVector()].attach(td.get());
-            //grid[pos.getRowVector()][pos.getColVector()].attach(gd.get());
-        }
-    }
-
-    // Knight move directions: (row offset, column offset)
-    const std::vector<std::pair<int, int>> knightMoves = {
-        {2, 1}, {1, 2}, {-1, 2}, {-2, 1},
-        {-2, -1}, {-1, -2}, {1, -2}, {2, -1}
-    };
-
-    for (size_t row = 0; row < GRID_SIZE; ++row) {
-        for (size_t column = 0; column < GRID_SIZE; ++column) {
-            // Attach adjacent 8 neighbors
-            for (int dr = -1; dr <= 1; ++dr) {
-                for (int dc = -1; dc <= 1; ++dc) {
-                    if (dr == 0 && dc == 0) continue;
-                    int nr = row + dr;
-                    int nc = column + dc;
-                    if (nr >= 0 && nr < GRID_SIZE && nc >= 0 && nc < GRID_SIZE) {
-                        grid[row][column].attach(&grid[nr][nc]); // Attach in only one direction
-                    }
-                }
-            }
-
-            // Attach knight-move neighbors
-            for (const auto& [dr, dc] : knightMoves) {
-                int nr = row + dr;
-                int nc = column + dc;
-                if (nr >= 0 && nr < GRID_SIZE && nc >= 0 && nc < GRID_SIZE) {
-                    grid[row][column].attach(&grid[nr][nc]);
-                }
-            }
+            grid[pos.getRowVector()][pos.getColVector()].setCell(Info{pos, bitPosition.colourOn(sq), bitPosition.pieceTypeOn(sq)});
+            showCell(sq);
         }
     }
 
-    // Set initial states for all cells
-    for (int i = 0; i < GRID_SIZE; ++i) {
-        for (int j = 0; j < GRID_SIZE; ++j) {
-            // to ensure each piece has state update or empty cell as appropriate
-            State state = (grid[i][j].getInfo().getPieceType() == PieceType::NONE) ? 
-                        State{StateType::EmptyCell, Colour::NONE, PieceType::NONE, grid[i][j].getInfo().getPosition(), Direction::N}
-                                                : State{StateType::Update, grid[i][j].getInfo().getColour(), 
-                                                    grid[i][j].getInfo().getPieceType(), grid[i][j].getInfo().getPosition(), Direction::N};
-            grid[i][j].setState(state);
-        }
-    }
-
-    whiteMoves.clear();
-    for (int i = 0; i < 8; ++i) {
-        for (int j = 0; j < 8; ++j) {
-            if (grid[i][j].getPiece().getColour() == Colour::WHITE) {
-                auto valid = grid[i][j].getAllValidMoves();
-                whiteMoves.insert(whiteMoves.end(), valid.begin(), valid.end());
-            }
-        }
-    }
-
-    blackMoves.clear();
-    for (int i = 0; i < 8; ++i) {
-        for (int j = 0; j < 8; ++j) {
-            if (grid[i][j].getPiece().getColour() == Colour::BLACK) {
-                auto valid = grid[i][j].getAllValidMoves();
-                blackMoves.insert(blackMoves.end(), valid.begin(), valid.end());
-            }
-        }
-    }
+    history.clear();
+    movesPlayed.clear();
+    dirty = ~Bitboard{0};
 }
 
-bool Board::movePiece(Move mv) {
-    movesPlayed.push_back(mv); // update moves played
-    Position from = mv.getFrom();
-    Position to = mv.getTo();
-
-    // Change king position if necessary
-    if(from == posBKing){
-        posBKing = to;
-    } else if (from == posWKing){
-        posWKing = to;
-    }
-
-    Piece capturingPiece = grid[from.getRowVector()][from.getColVector()].getPiece(); // moving piece
-    capturingPiece.incrementMoveCount();
-
-    // Setting from and to piece types and states
-    grid[from.getRowVector()][from.getColVector()].setPiece(Piece{PieceType::NONE, Colour::NONE});
-    grid[from.getRowVector()][from.getColVector()].setState(State{StateType::EmptyCell, Colour::NONE, PieceType::NONE, from, Direction::N});
-
-    grid[to.getRowVector()][to.getColVector()].setPiece(capturingPiece);
-    grid[to.getRowVector()][to.getColVector()].setState(State{StateType::NewPiece, capturingPiece.getColour(), 
-                                                        capturingPiece.getPieceType(), to, Direction::N});
-    
-    //Notify rest
-    grid[from.getRowVector()][from.getColVector()].notifyObservers();
-    grid[to.getRowVector()][to.getColVector()].notifyObservers();
-
-    // Change turn
-    currentTurn = (currentTurn == Colour::WHITE) ? Colour::BLACK : Colour::WHITE;
-
-    whiteMoves.clear();
-    for(int i = 0; i < 8; ++i) {
-        for(int j = 0; j < 8; ++j) {
-            if(grid[i][j].getPiece().getColour() == Colour::WHITE) {
-                whiteMoves.insert(whiteMoves.end(), grid[i][j].getAllValidMoves().begin(), grid[i][j].getAllValidMoves().end());
-            }
-        }
-    }
+Cell &Board::cellAt(int sq) {
+    return grid[rankOf(sq)][fileOf(sq)];
+}
 
-    blackMoves.clear();
-    for(int i = 0; i < 8; ++i) {
-        for(int j = 0; j < 8; ++j) {
-            if(grid[i][j].getPiece().getColour() == Colour::BLACK) {
-                blackMoves.insert(blackMoves.end(), grid[i][j].getAllValidMoves().begin(), grid[i][j].getAllValidMoves().end());
-                cout << "Move inserted - black" << endl;
-            }
-        }
-    }
-    
-    return true; // Returns true if movePiece successful
+// Tells the display sink, if this board has one, what is on sq now
+void Board::showCell(int sq) {
+    ++notifications;
+    if(td) td->notify(sq, cellAt(sq).getPiece());
 }
 
-bool Board::isCheck() {
-    //Going through a list to see if the piece attacked is ever a king
-    if(currentTurn == Colour::WHITE) {
-        for(Move mv : blackMoves) {
-            if(mv.isCaptured() && mv.getPieceType() == PieceType::KING)
-                return true;
-        }
+// Marks the squares whose pieces may have gained or lost moves because the squares in changed
+// were emptied or filled: sliders looking through them, leapers and pawns next to them, pawns
+// that could capture en passant before or after, and both kings, whose safe squares can change
+// after any move. Everything else keeps its move list.
+void Board::markDirty(Bitboard changed, Bitboard occBefore, int epBefore) {
+    Bitboard occAfter = bitPosition.getOccupied();
+    Bitboard region = changed | shiftNorth(shiftNorth(changed)) | shiftSouth(shiftSouth(changed));
+    for(Bitboard b = changed; b; ) {
+        int sq = popLsb(b);
+        region |= queenAttacks(sq, occBefore) | queenAttacks(sq, occAfter) | knightAttacks[sq] | kingAttacks[sq];
     }
-    else {
-        for(Move mv : whiteMoves) {
-            if(mv.isCaptured() && mv.getPieceType() == PieceType::KING)
-                return true;
-        }
+    for(int ep : {epBefore, bitPosition.getEpSquare()}) {
+        if(ep != NO_SQUARE) region |= pawnAttacks[0][ep] | pawnAttacks[1][ep];
     }
-    return false;
+    region |= bitPosition.getPieces(Colour::WHITE, PieceType::KING) | bitPosition.getPieces(Colour::BLACK, PieceType::KING);
+    dirty |= region;
 }
 
-bool Board::isCheckmate() {
-    vector<Move> checkingMoves; // list of moves that are check
-    Colour checker;
-    if(currentTurn == Colour::WHITE) {
-        checker = Colour::BLACK; // this colour did the check - challenger
-        for(Move mv : blackMoves) {
-            if(mv.getPieceType() == PieceType::KING) {
-                checkingMoves.push_back(mv);
-            }
+// Regenerates the dirty squares' moves and splices the side lists back together
+void Board::updateMoveLists() {
+    if(!dirty) return;
+
+    for(Bitboard b = dirty; b; ) squareMoves[popLsb(b)].count = 0;
+
+    for(Colour colour : {Colour::WHITE, Colour::BLACK}) {
+        BitPosition view = bitPosition;
+        view.setSideToMove(colour);
+        int c = colourIndex(colour);
+        Bitboard own = view.getOccupancy(colour);
+        int ksq = view.kingSquare(colour);
+
+        // Check restricts every piece, and a pin restricts the pinned piece wherever the move was
+        Bitboard pinned = view.pinnedPieces(colour);
+        Bitboard checkers = view.getCheckers();
+        Bitboard regen = dirty | (pinned ^ lastPinned[c]);
+        if(checkers || lastCheckers[c] || ksq != lastKing[c]) regen = own;
+        regen &= own;
+        lastPinned[c] = pinned;
+        lastCheckers[c] = checkers;
+        lastKing[c] = ksq;
+
+        for(Bitboard b = regen; b; ) squareMoves[popLsb(b)].count = 0;
+        MoveList fresh;
+        view.generateLegalMoves(fresh, regen);
+        for(PackedMove mv : fresh) {
+            SquareMoves &sm = squareMoves[mv.getFrom()];
+            sm.moves[sm.count++] = mv;
         }
-    }
-    else {
-        checker = Colour::WHITE;
-        for(Move mv : whiteMoves) {
-            if(mv.getPieceType() == PieceType::KING) {
-                checkingMoves.push_back(mv);
-            }
+
+        MoveList &list = (colour == Colour::WHITE) ? whiteMoves : blackMoves;
+        list.clear();
+        for(Bitboard b = own; b; ) {
+            const SquareMoves &sm = squareMoves[popLsb(b)];
+            for(int i = 0; i < sm.count; ++i) list.add(sm.moves[i]);
         }
     }
 
-    //If no check, checkmate is false
-    if(checkingMoves.size() == 0)
-        return false;
-
-    vector<Move> kingValidMoves;
-    if(checker == Colour::WHITE) // checker is the attacker
-        kingValidMoves = grid[posBKing.getRowVector()][posBKing.getColVector()].getAllValidMoves();
-    else
-        kingValidMoves = grid[posWKing.getRowVector()][posWKing.getColVector()].getAllValidMoves();
-
-    //If more than one checker, king has to move
-    if(checkingMoves.size() > 1) {
-
-        // Now since we know the only valid moves are the kings moves, we can update the list of 
-        // valid moves accordingly
-        if(checker == Colour::WHITE) {
-            blackMoves.clear();
-            blackMoves = kingValidMoves;
-        }
-        else {
-            whiteMoves.clear();
-            whiteMoves = kingValidMoves;
-        }
+    dirty = 0;
+}
 
-        //Checking Checkmate condition
-        if(checker == Colour::WHITE &&
-           (kingValidMoves.size() == 0))
-            return true;
-            
-        if(checker == Colour::BLACK &&
-           (kingValidMoves.size() == 0))
-            return true;
-        
-        // More than one attacker and king has space to move
-        return false;
+void Board::makeMove(Move mv) {
+    PackedMove packed = bitPosition.pack(mv);
+    int from = packed.getFrom();
+    int to = packed.getTo();
+    Colour us = bitPosition.getSideToMove();
+
+    Piece movingPiece = cellAt(from).getPiece();
+    movingPiece.incrementMoveCount();
+    if(packed.isPromotion()) movingPiece = Piece{packed.getPromotion(), us};
+
+    // The flags say which cells change besides from and to
+    CellChanges placed;
+    placed.add(from, Piece{});
+    if(packed.isEnPassant()) {
+        placed.add((us == Colour::WHITE) ? to - 8 : to + 8, Piece{});
+    } else if(packed.isCastle()) {
+        bool kingSide = packed.getFlags() == PackedMove::KING_CASTLE;
+        int rookFrom = kingSide ? to + 1 : to - 2;
+        Piece rook = cellAt(rookFrom).getPiece();
+        rook.incrementMoveCount();
+        placed.add(rookFrom, Piece{});
+        placed.add(kingSide ? to - 1 : to + 1, rook);
     }
+    placed.add(to, movingPiece);
+
+    PlyRecord record{mv, packed, {}, {}};
+    Bitboard occBefore = bitPosition.getOccupied();
+    bitPosition.makeMove(packed, record.undo);
+
+    Bitboard changed = 0;
+    for(auto &[sq, piece] : placed) {
+        record.cells.add(sq, cellAt(sq).getPiece());
+        cellAt(sq).setPiece(piece);
+        showCell(sq);
+        changed |= squareBB(sq);
+    }
+    markDirty(changed, occBefore, record.undo.epSquare);
 
+    history.push_back(record);
+    movesPlayed.push_back(mv);
+}
 
-    //If knight is checker, king has to move (Only one knight can check at a time)
-    Move check = checkingMoves[0];
-    Position from = check.getFrom();
-    Position to = check.getTo();
-    if ((abs(to.getRow() - from.getRow()) == 2 && abs(to.getColInt() - from.getColInt()) == 1) ||
-    (abs(to.getRow() - from.getRow()) == 1 && abs(to.getColInt() - from.getColInt()) == 2)) {
-
-        vector<Move> tempValidMoves;
-
-        //Black King has no moves
-        if(checker == Colour::WHITE &&
-           kingValidMoves.size() == 0) {
-            for(Move mv : blackMoves) {
-                if(check.getFrom() == mv.getTo()) {
-                    tempValidMoves.push_back(mv);
-                }
-            }
-            if(tempValidMoves.size() > 0) {
-                blackMoves.clear();
-                blackMoves = tempValidMoves;
-                return false;
-            } else {
-                return true;
-            }
-           }
-        
-        //White King has no moves
-        else if(checker == Colour::BLACK &&
-           (kingValidMoves.size() == 0)) {
-            for(Move mv : whiteMoves) {
-                if(check.getFrom() == mv.getTo()) {
-                    tempValidMoves.push_back(mv);
-                }
-            }
-            if(tempValidMoves.size() > 0) {
-                whiteMoves.clear();
-                whiteMoves = tempValidMoves;
-                return false;
-            } else {
-                return true;
-            }
-           }
-
-        //Black King does have moves
-        else if(checker == Colour::WHITE) {
-            for(Move mv : blackMoves) {
-                if(check.getFrom() == mv.getTo()) {
-                    tempValidMoves.push_back(mv);
-                }
-            }
-
-            //Adding king's valid moves to the list
-            tempValidMoves.insert(tempValidMoves.end(), kingValidMoves.begin(), kingValidMoves.end());
-            blackMoves.clear();
-            blackMoves = tempValidMoves;
-            return false;
-        }
-
-        //White King does have moves
-        else {
-            for(Move mv : whiteMoves) {
-                if(check.getFrom() == mv.getTo()) {
-                    tempValidMoves.push_back(mv);
-                }
-            }
-
-            //Adding king's valid moves to the list
-            tempValidMoves.insert(tempValidMoves.end(), kingValidMoves.begin(), kingValidMoves.end());
-            whiteMoves.clear();
-            whiteMoves = tempValidMoves;
-            return false;
-        }
-    }
+Move Board::unmakeMove() {
+    PlyRecord record = history.back();
+    history.pop_back();
+    movesPlayed.pop_back();
 
-    vector<Move> tempValidMoves;
+    Bitboard occBefore = bitPosition.getOccupied();
+    int epBefore = bitPosition.getEpSquare();
+    bitPosition.unmakeMove(record.packed, record.undo);
 
-    // Adding the moves that capture the attacker 
-    if(checker == Colour::WHITE){
-        for(Move mv: blackMoves){
-            if(check.getFrom() == mv.getTo()) {
-                tempValidMoves.push_back(mv);
-            }
-        }
-    } else {
-        for(Move mv: whiteMoves){
-            if(check.getFrom() == mv.getTo()) {
-                tempValidMoves.push_back(mv);
-            }
-        }
+    Bitboard changed = 0;
+    for(auto &[sq, piece] : record.cells) {
+        cellAt(sq).setPiece(piece);
+        showCell(sq);
+        changed |= squareBB(sq);
     }
+    markDirty(changed, occBefore, epBefore);
+    return record.move;
+}
 
-    // check is still the only move checking it. So we find all positions between the from and to
-    // positions of this move and check which valid move can get in the way (including capture)
-    vector<Position> positions = Position::getAllPositions(from, to);
-
-    // Now positions contains all the list of positions where it can be blocked.
-    // Hence all moves where a piece can enter this square is valid
-    if(checker == Colour::BLACK) {
-        for(Move mv : whiteMoves) {
-            for(Position pos : positions) {
-                if(mv.getTo() == pos)
-                    tempValidMoves.push_back(mv);
-            }
-        }
-    } else {
-        for(Move mv : blackMoves) {
-            for(Position pos : positions) {
-                if(mv.getTo() == pos)
-                    tempValidMoves.push_back(mv);
-            }
-        } 
-    }
+bool Board::canUndo() const {
+    return !history.empty();
+}
 
-    // Adding the King's valid moves
-    tempValidMoves.insert(tempValidMoves.end(), kingValidMoves.begin(), kingValidMoves.end());
+bool Board::movePiece(Move mv) {
+    makeMove(mv);
+    return true; // Returns true if movePiece successful
+}
 
-    //Checking if there are any valid moves for that side to play;
-    if(tempValidMoves.size() == 0)
-        return true;
-    else {
-        if(checker == Colour::WHITE) {
-            blackMoves.clear();
-            blackMoves = tempValidMoves;
-        }
-        else {
-            whiteMoves.clear();
-            whiteMoves = tempValidMoves;
-        }
-        return false;
-    }
+bool Board::isCheck() const {
+    return bitPosition.inCheck();
+}
 
+bool Board::isCheckmate() const {
+    return bitPosition.inCheck() && !bitPosition.hasLegalMove();
 }
 
-bool Board::isStalemate() {
-    if(currentTurn == Colour::WHITE)
-        return (0 == whiteMoves.size());
-    else
-        return (0 == blackMoves.size());
+bool Board::isStalemate() const {
+    return !bitPosition.inCheck() && !bitPosition.hasLegalMove();
 }
 
 const vector<vector<Cell>>& Board::getGrid(){
@@ -402,11 +202,12 @@ const vector<vector<Cell>>& Board::getGrid(){
 }
 
 void Board::setCurrentTurn(Colour colour) {
-    currentTurn = colour;
+    bitPosition.setSideToMove(colour);
+    dirty = ~Bitboard{0};
 }
 
 Colour Board::getCurrentTurn() {
-    return currentTurn;
+    return bitPosition.getSideToMove();
 }
 
 void Board::pushMove(Move mv) {
@@ -414,27 +215,60 @@ void Board::pushMove(Move mv) {
 }
 
 Move Board::popMove() {
-    int last = movesPlayed.size() - 1;
+    Move last = movesPlayed.back();
     movesPlayed.pop_back();
-    return movesPlayed[last];
+    return last;
 }
 
 vector<Move> Board::getBlackMoves() {
-    return blackMoves;
+    vector<Move> moves;
+    for(PackedMove mv : getBlackMoveList()) moves.push_back(bitPosition.unpack(mv));
+    return moves;
 }
 
 vector<Move> Board::getWhiteMoves() {
-    return whiteMoves;
+    vector<Move> moves;
+    for(PackedMove mv : getWhiteMoveList()) moves.push_back(bitPosition.unpack(mv));
+    return moves;
+}
+
+span<const PackedMove> Board::getBlackMoveList() {
+    updateMoveLists();
+    return blackMoves.view();
+}
+
+span<const PackedMove> Board::getWhiteMoveList() {
+    updateMoveLists();
+    return whiteMoves.view();
 }
 
 Position Board::getBKing() {
-    return posBKing;
+    return positionOf(bitPosition.kingSquare(Colour::BLACK));
 }
 
 Position Board::getWKing() {
-    return posWKing;
+    return positionOf(bitPosition.kingSquare(Colour::WHITE));
+}
+
+const BitPosition &Board::getBitPosition() const {
+    return bitPosition;
+}
+
+Key Board::getKey() const {
+    return bitPosition.getKey();
+}
+
+vector<Key> Board::getKeyHistory() const {
+    vector<Key> keys;
+    keys.reserve(history.size());
+    for(const PlyRecord &record : history) keys.push_back(record.undo.key);
+    return keys;
+}
+
+long Board::getNotificationCount() const {
+    return notifications;
 }
 
 void Board::printTD(){
-    cout << *td << endl;
+    if(td) cout << *td << endl;
 }
@@ -6,28 +6,77 @@
 #include "position.h"
 #include "move.h"
 #include "enumerated.h"
+#include "bitPosition.h"
 #include <vector>
-#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
 
 class Board {
+    // Cells one move changes, with a piece for each: from and to, plus the captured pawn's square
+    // for en passant or the rook's two squares for castling. Stored inline like MoveList
+    struct CellChanges {
+        static const int MAX_CELLS = 4;
+        std::pair<int, Piece> cells[MAX_CELLS];
+        int count = 0;
+
+        void add(int sq, Piece piece) { cells[count++] = {sq, piece}; }
+        const std::pair<int, Piece> *begin() const { return cells; }
+        const std::pair<int, Piece> *end() const { return cells + count; }
+    };
+
+    // What unmakeMove needs: the bitboard undo record plus the cells' previous pieces
+    struct PlyRecord {
+        Move move;
+        PackedMove packed;
+        UndoInfo undo;
+        CellChanges cells;
+    };
+
+    // Legal moves of the piece on one square; a queen has at most 27
+    struct SquareMoves {
+        int count = 0;
+        PackedMove moves[28];
+    };
+
     std::vector<std::vector<Cell>> grid;
+    BitPosition bitPosition; // authoritative piece placement; grid mirrors it for the displays
     std::vector<Move> movesPlayed;
-    std::vector<Move> blackMoves;
-    std::vector<Move> whiteMoves;
-    std::unique_ptr<TextDisplay> td;   // Changed to unique_ptr
+    MoveList blackMoves;
+    MoveList whiteMoves;
+    SquareMoves squareMoves[NUM_SQUARES]; // whiteMoves/blackMoves are spliced together from these
+    Bitboard dirty = ~Bitboard{0};        // squares whose moves must be regenerated before the next query
+    Bitboard lastPinned[2] = {};          // per colour, as of the last regeneration
+    Bitboard lastCheckers[2] = {};
+    int lastKing[2] = {NO_SQUARE, NO_SQUARE};
+    std::vector<PlyRecord> history;
+    std::optional<TextDisplay> td;  // display sink; boards used only for analysis go without
+    long notifications = 0;         // squares reported to the display since construction
     //std::unique_ptr<GraphicsDisplay> gd; // Changed to unique_ptr
-    Position posBKing;
-    Position posWKing;
-    Colour currentTurn;
+
+    Cell &cellAt(int sq);
+    void showCell(int sq);
+    void markDirty(Bitboard changed, Bitboard occBefore, int epBefore);
+    void updateMoveLists();
+    void initCells(bool withDisplay);
 
     public:
-    void init(std::vector<std::vector<char>> config);  // places the pieces on an empty board
-                                                       // attach observers; neighbours plus displays
-    bool movePiece(Move mv);
+    // Places the pieces on an empty board. Boards are plain values and may be copied freely
+    void init(std::vector<std::vector<char>> config, bool withDisplay = true);
+    // Loads a FEN with its side to move, castling rights, en passant square and clocks.
+    // Returns false and leaves the board unchanged if the FEN is malformed
+    bool fromFEN(std::string_view fen, bool withDisplay = true);
+    std::string toFEN() const;
+    bool movePiece(Move mv);   // makeMove for a move played in the game
+
+    void makeMove(Move mv);    // plays mv and pushes an undo record
+    Move unmakeMove();         // restores the position before the last makeMove
+    bool canUndo() const;
 
-    bool isCheck();
-    bool isCheckmate();
-    bool isStalemate();
+    bool isCheck() const;
+    bool isCheckmate() const;
+    bool isStalemate() const;
 
     void setCurrentTurn(Colour colour);
     Colour getCurrentTurn();
@@ -37,8 +86,14 @@ class Board {
     const std::vector<std::vector<Cell>>& getGrid();
     std::vector<Move> getBlackMoves();
     std::vector<Move> getWhiteMoves();
+    std::span<const PackedMove> getBlackMoveList(); // read-only views, no copies
+    std::span<const PackedMove> getWhiteMoveList();
     Position getBKing();
     Position getWKing();
+    const BitPosition &getBitPosition() const;
+    Key getKey() const;      // Zobrist hash of the current position
+    std::vector<Key> getKeyHistory() const; // keys of the positions before each move played, oldest first
+    long getNotificationCount() const; // display notifications so far, with or without a display
 
     void printTD();
 };
@@ -1,6 +1,7 @@
 #include "computerPlayer.h"
-#include "position.h"
+#include "see.h"
 #include <string>
+#include <iostream>
 #include <stdlib.h>
 #include <sstream>
 #include <cstdio>   // for popen, pclose
@@ -8,8 +9,8 @@
 using namespace std;
 
 // Constructor
-ComputerPlayer::ComputerPlayer(Colour colour, int level)
-    : Player{colour}, level{level} {}
+ComputerPlayer::ComputerPlayer(Colour colour, int level, Search *search)
+    : Player{colour}, level{level}, search{search} {}
 
 // Level accessor - returns int
 int ComputerPlayer::getLevel() {
@@ -20,9 +21,7 @@ Move ComputerPlayer::getMove(Board *board) const {
     Move ret;
     vector<Move> validMoves;
     vector<Move> opponentMoves;
-    vector<Position> positionsBetween;
-    PieceType checker;
-    bool blocker = false;
+    const BitPosition &position = board->getBitPosition();
     int num = 0;
 
     if(getColour() == Colour::WHITE) {
@@ -32,8 +31,15 @@ Move ComputerPlayer::getMove(Board *board) const {
         validMoves = board->getBlackMoves();
         opponentMoves = board->getWhiteMoves();
     }
-    
-    Position posKing;
+
+    // Fallback for every level: any legal move, a quiet one where there is one
+    ret = validMoves[0];
+    for(Move mv : validMoves) {
+        if(!position.pack(mv).isCapture()) {
+            ret = mv;
+            break;
+        }
+    }
     switch(level){
         case 1:
             srand(time(0));
@@ -55,119 +61,50 @@ Move ComputerPlayer::getMove(Board *board) const {
 
         case 2:
 
-            //Prefers capturing moves
-            for(Move mv : validMoves) {
-                if(!(mv.getPieceType() == PieceType::NONE)) {
-                    ret = mv;
-                    break;
+            // Prefers the capture that wins the most material once the exchange is played out,
+            // never one that loses it
+            {
+                // ret may already hold a capture (the fallback, or level 3's pick) that loses
+                // material, so an even capture must still replace it
+                int bestGain = 0;
+                bool foundCapture = false;
+                for(Move mv : validMoves) {
+                    PackedMove pm = position.pack(mv); // en passant takes a pawn from an empty square
+                    if(!pm.isCapture()) continue;
+                    int gain = see(position, pm);
+                    if(gain > bestGain || (gain == bestGain && !foundCapture)) {
+                        bestGain = gain;
+                        foundCapture = true;
+                        ret = mv;
+                    }
                 }
             }
 
-            // Prefers checks
-            if(getColour() == Colour::WHITE)
-                posKing = board->getBKing();
-            else
-                posKing = board->getWKing();
-
+            // Prefers checks, direct or discovered, tested on the bitboards without playing the move,
+            // as long as the checking piece is not simply lost: a quiet check to an unattacked
+            // square exchanges nothing, so see() covers both
             for(Move mv : validMoves) {
-                //checker piece type is the piece type of the attacker
-                checker = board->getGrid()[mv.getFrom().getRowVector()][mv.getFrom().getColVector()].getPieceType();
-
-                // If attacker is knight
-                if(checker == PieceType::KNIGHT &&
-                   ((abs(mv.getTo().getRowVector() - posKing.getRowVector()) == 2 && 
-                    abs(mv.getTo().getColVector() - posKing.getColVector()) == 1) ||
-                   (abs(mv.getTo().getRowVector() - posKing.getRowVector()) == 1 && 
-                    abs(mv.getTo().getColVector() - posKing.getColVector()) == 2))) {
+                PackedMove pm = position.pack(mv);
+                if(position.givesCheck(pm) && see(position, pm) >= 0) {
                     ret = mv;
                     break;
                 }
-
-                //If attacker is bishop
-                if(checker == PieceType::BISHOP &&
-                   abs(mv.getTo().getRowVector() - posKing.getRowVector()) == 
-                   abs(mv.getTo().getColVector() - posKing.getColVector())) {
-                    positionsBetween = Position::getAllPositions(mv.getTo(), posKing);
-
-                    //Checking if there is a blocker
-                    for(Position pos : positionsBetween) {
-                        if(board->getGrid()[pos.getRowVector()][pos.getColVector()].getPieceType() != PieceType::NONE){
-                            blocker = true;
-                            break;
-                        }
-                    }
-                    if(!blocker) {
-                        ret = mv;
-                        break;
-                    }
-                    
-                    blocker = false;
-                }
-
-                // If attacker is a rook
-                if(checker == PieceType::ROOK &&
-                   ((mv.getTo().getRowVector() - posKing.getRowVector()) == 0 ||
-                   (mv.getTo().getColVector() - posKing.getColVector()) == 0)) {
-                    positionsBetween = Position::getAllPositions(mv.getTo(), posKing);
-
-                    //Checking if there is a blocker
-                    for(Position pos : positionsBetween) {
-                        if(board->getGrid()[pos.getRowVector()][pos.getColVector()].getPieceType() != PieceType::NONE){
-                            blocker = true;
-                            break;
-                        }
-                    }
-                    if(!blocker) {
-                        ret = mv;
-                        break;
-                    }
-                    
-                    blocker = false;
-                }
-
-                if(checker == PieceType::QUEEN &&
-                   (((mv.getTo().getRowVector() - posKing.getRowVector()) == 0 ||
-                    (mv.getTo().getColVector() - posKing.getColVector()) == 0) ||
-                   (abs(mv.getTo().getRowVector() - posKing.getRowVector()) == 
-                    abs(mv.getTo().getColVector() - posKing.getColVector())))) {
-                        positionsBetween = Position::getAllPositions(mv.getTo(), posKing);
-
-                    //Checking if there is a blocker
-                    for(Position pos : positionsBetween) {
-                        if(board->getGrid()[pos.getRowVector()][pos.getColVector()].getPieceType() != PieceType::NONE){
-                            blocker = true;
-                            break;
-                        }
-                    }
-                    if(!blocker) {
-                        ret = mv;
-                        break;
-                    }
-                    
-                    blocker = false;
-                }
-
-                // Only other possible piece that can check is pawn
-                if(getColour() == Colour::WHITE) {
-                    if((posKing.getRow() - mv.getTo().getRow()) == 1 &&
-                        abs(posKing.getColInt() - mv.getTo().getRow()) == 1) {
-                            ret = mv;
-                            break;
-                    }
-                }
-
-                else if(getColour() == Colour::BLACK) {
-                    if((mv.getTo().getRow() - posKing.getRow()) == 1 &&
-                        abs(posKing.getColInt() - mv.getTo().getRow()) == 1) {
-                            ret = mv;
-                            break;
-                    }
-                }
             }
+            break;
 
-            // Play any move
-            ret = validMoves[0];
+        case 4: {
+            // Searches as deep as the depth and time limits allow
+            if(!search) break;
+            SearchResult result = search->think(position, board->getKeyHistory());
+            cout << "Depth: " << result.depth << "  Score: " << result.score
+                 << "  Nodes: " << result.nodes << "  Time: " << static_cast<int>(result.seconds * 1000) << " ms"
+                 << "  NPS: " << (result.seconds > 0 ? static_cast<uint64_t>(result.nodes / result.seconds) : 0)
+                 << "  TT hits: " << (result.ttProbes ? 100 * result.ttHits / result.ttProbes : 0) << "%"
+                 << "  Pawn hits: " << (result.pawnProbes ? 100 * result.pawnHits / result.pawnProbes : 0) << "%"
+                 << "  Hashfull: " << result.hashfull << endl;
+            if(!result.best.isNone()) ret = position.unpack(result.best);
             break;
+        }
     }
     return ret;
 }
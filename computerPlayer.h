@@ -5,13 +5,15 @@
 #include "move.h"
 #include "board.h"
 #include "enumerated.h"
+#include "search.h"
 #include <string>
 
 class ComputerPlayer : public Player {
     int level;
+    Search *search; // level 4 only; owned by Game so its settings outlive a single game
 
   public:
-    ComputerPlayer(Colour colour, int level);
+    ComputerPlayer(Colour colour, int level, Search *search = nullptr);
     Move getMove(Board *board) const override;
     int getLevel();
 };
@@ -0,0 +1,43 @@
+#include "evaluate.h"
+#include "pieceSquareTables.h"
+#include <algorithm>
+#include <cstdlib>
+
+using namespace std;
+
+// Endgame bonus per rank of a passed pawn's progress, for the kings' distances to its stop square
+const int PASSER_KING_DISTANCE = 2;
+
+static int distance(int a, int b) {
+    return max(abs(rankOf(a) - rankOf(b)), abs(fileOf(a) - fileOf(b)));
+}
+
+int evaluate(const BitPosition &pos, PawnTable &pawns, NnueStack &nnue, int ply) {
+    return networkLoaded() ? nnue.evaluate(pos, ply) : evaluateClassical(pos, pawns);
+}
+
+int evaluateClassical(const BitPosition &pos, PawnTable &pawns) {
+    PawnEntry &entry = pawns.probe(pos);
+    int midgame = pos.getMidgameScore() + entry.midgame
+                + entry.kingShelter(pos, Colour::WHITE) - entry.kingShelter(pos, Colour::BLACK);
+    int endgame = pos.getEndgameScore() + entry.endgame;
+
+    // Passed pawns need the kings, which the pawn entry does not know: a passer is worth more
+    // the further the enemy king is from its path and the closer its own
+    for (Colour colour : {Colour::WHITE, Colour::BLACK}) {
+        int sign = colour == Colour::WHITE ? 1 : -1;
+        int ownKing = pos.kingSquare(colour);
+        int enemyKing = pos.kingSquare(opposite(colour));
+        for (Bitboard b = entry.passed[colourIndex(colour)]; b; b &= b - 1) {
+            int sq = lsb(b);
+            int progress = colour == Colour::WHITE ? rankOf(sq) - 2 : 5 - rankOf(sq);
+            if (progress <= 0) continue;
+            int stop = colour == Colour::WHITE ? sq + 8 : sq - 8;
+            endgame += sign * PASSER_KING_DISTANCE * progress * (2 * distance(enemyKing, stop) - distance(ownKing, stop));
+        }
+    }
+
+    int phase = min(pos.getPhase(), MAX_PHASE); // promotions can take it past the starting position
+    int score = (midgame * phase + endgame * (MAX_PHASE - phase)) / MAX_PHASE;
+    return pos.getSideToMove() == Colour::WHITE ? score : -score;
+}
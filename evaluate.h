@@ -0,0 +1,21 @@
+#ifndef EVALUATE_H
+#define EVALUATE_H
+#include "bitPosition.h"
+#include "nnue.h"
+#include "pawns.h"
+
+// Centipawn values indexed by pieceIndex (king, queen, bishop, rook, knight, pawn), for the
+// exchange and move ordering arithmetic; the evaluation itself uses pieceSquareTables.h
+const int PIECE_VALUES[6] = {0, 900, 330, 500, 320, 100};
+
+// Static evaluation in centipawns from the side to move's point of view: the network's when one
+// is loaded (see nnue.h), otherwise the hand-crafted one. pawns and nnue are the calling thread's;
+// pos is the position at ply in nnue.
+int evaluate(const BitPosition &pos, PawnTable &pawns, NnueStack &nnue, int ply);
+
+// Material and piece-square values, which BitPosition keeps up to date as pieces move, plus the
+// pawn structure and king shelter from the pawn cache, tapered between middlegame and endgame by
+// the game phase
+int evaluateClassical(const BitPosition &pos, PawnTable &pawns);
+
+#endif
@@ -1,5 +1,6 @@
 #include <memory>
 #include <string>
+#include <cctype>
 #include "game.h"
 #include "humanPlayer.h"
 #include "computerPlayer.h"
@@ -50,6 +51,10 @@ Board *Game::getBoard() {
     return board.get();
 }
 
+Search &Game::getSearch() {
+    return search;
+}
+
 vector<Move> Game::getBlackMoves() {
     return board->getBlackMoves();
 }
@@ -58,6 +63,14 @@ vector<Move> Game::getWhiteMoves() {
     return board->getWhiteMoves();
 }
 
+span<const PackedMove> Game::getBlackMoveList() {
+    return board->getBlackMoveList();
+}
+
+span<const PackedMove> Game::getWhiteMoveList() {
+    return board->getWhiteMoveList();
+}
+
 void Game::start(string player1, string player2, Colour colour) {
 
     // Reset previous state
@@ -75,7 +88,7 @@ void Game::start(string player1, string player2, Colour colour) {
     } else if(player1 == "computer3"){
         whitePlayer = make_unique<ComputerPlayer>(Colour::WHITE, 3);
     } else{
-        whitePlayer = make_unique<ComputerPlayer>(Colour::WHITE, 4);
+        whitePlayer = make_unique<ComputerPlayer>(Colour::WHITE, 4, &search);
     }
 
     if(player2 == "human"){
@@ -87,7 +100,7 @@ void Game::start(string player1, string player2, Colour colour) {
     } else if(player2 == "computer3"){
         blackPlayer = make_unique<ComputerPlayer>(Colour::BLACK, 3);
     } else{
-        blackPlayer = make_unique<ComputerPlayer>(Colour::BLACK, 4);
+        blackPlayer = make_unique<ComputerPlayer>(Colour::BLACK, 4, &search);
     } 
 
     if(colour == Colour::WHITE){
@@ -97,8 +110,10 @@ void Game::start(string player1, string player2, Colour colour) {
     }
 
     board = make_unique<Board>();
-    board->setCurrentTurn(colour);
-    board->init(config);
+    if(setupFEN.empty() || !board->fromFEN(setupFEN)){
+        board->setCurrentTurn(colour);
+        board->init(config);
+    }
 
     // Print textdisplay
     board->printTD();
@@ -106,18 +121,18 @@ void Game::start(string player1, string player2, Colour colour) {
 
 bool Game::isValidMove(Move move) {
     Player *player = getCurrentTurn();
+    PackedMove packed = board->getBitPosition().pack(move);
 
+    span<const PackedMove> legal;
     if(player->getColour() == Colour::WHITE){
-        for(const auto& m : getWhiteMoves()){
-            if(m == move){
-                return true;
-            }
-        }
+        legal = getWhiteMoveList();
     } else if(player->getColour() == Colour::BLACK){
-        for(const auto& m : getBlackMoves()){
-            if(m == move){
-                return true;
-            }
+        legal = getBlackMoveList();
+    }
+
+    for(PackedMove m : legal){
+        if(m == packed){
+            return true;
         }
     }
     return false;
@@ -151,25 +166,76 @@ bool Game::isSetupValid() {
         return false;
     }
 
-    Board tempBoard;
-    tempBoard.init(config);
+    // Neither king may start in check, whichever side moves first
+    BitPosition setup;
+    setup.setFromConfig(config, Colour::WHITE);
+    for(Colour side : {Colour::WHITE, Colour::BLACK}) {
+        BitPosition probe = setup;
+        probe.setSideToMove(side);
+        if(probe.inCheck()){
+            return false;
+        }
+    }
+    return true;
+}
 
-    if(tempBoard.isCheck()){
+
+bool Game::setupFromFEN(const string &fen, Colour &turn) {
+    BitPosition pos;
+    if(!pos.setFromFEN(fen)){
         return false;
     }
+
+    for(int i = 0; i < 8; i++){
+        for(int j = 0; j < 8; j++){
+            int sq = makeSquare(i, j);
+            char ch = ((i + j) % 2 == 0) ? '_' : ' ';
+            if(pos.pieceTypeOn(sq) != PieceType::NONE){
+                ch = "KQBRNP"[pieceIndex(pos.pieceTypeOn(sq))];
+                if(pos.colourOn(sq) == Colour::BLACK) ch = tolower(ch);
+            }
+            config[i][j] = ch;
+        }
+    }
+    turn = pos.getSideToMove();
+    setupFEN = fen;
     return true;
 }
 
+// The position a new game would start from: the setup FEN if there is one, else config
+BitPosition Game::getSetupPosition(Colour turn) const {
+    BitPosition pos;
+    if(setupFEN.empty() || !pos.setFromFEN(setupFEN)){
+        pos.setFromConfig(config, turn);
+    }
+    return pos;
+}
 
 bool Game::gameMove() {
     Move mv = currentTurn->getMove(getBoard());
-    if(isValidMove(mv)){
-        cout << (board->getGrid())[mv.getFrom().getRowVector()][mv.getFrom().getColVector()].getPieceType() <<" moved from " << mv.getFrom() << " to " << mv.getTo() << endl;
-        return board->movePiece(mv);
-    } else {
+    if(!isValidMove(mv)){
+        return false;
+    }
+
+    cout << (board->getGrid())[mv.getFrom().getRowVector()][mv.getFrom().getColVector()].getPieceType() <<" moved from " << mv.getFrom() << " to " << mv.getTo() << endl;
+    board->movePiece(mv);
+    currentTurn = (currentTurn == getWhitePlayer()) ? getBlackPlayer() : getWhitePlayer();
+
+    // Print textdisplay
+    board->printTD();
+    return true;
+}
+
+bool Game::undoMove() {
+    if(!board->canUndo()){
         return false;
     }
 
+    Move mv = board->unmakeMove();
+    cout << "Took back the move from " << mv.getFrom() << " to " << mv.getTo() << endl;
+    currentTurn = (currentTurn == getWhitePlayer()) ? getBlackPlayer() : getWhitePlayer();
+
     // Print textdisplay
     board->printTD();
+    return true;
 }
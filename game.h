@@ -3,8 +3,10 @@
 #include "board.h"
 #include "player.h"
 #include "move.h"
+#include "search.h"
 #include <vector>
 #include <memory>
+#include <span>
 #include <string>
 
 class Game {
@@ -14,12 +16,14 @@ class Game {
     std::unique_ptr<Player> blackPlayer;
     double whiteWins = 0;
     double blackWins = 0;
+    Search search; // shared by computer4 players
     bool isValidMove(Move move);
-    static const std::vector<std::vector<char>> DEFAULT_CONFIG;
 
     public:
+    static const std::vector<std::vector<char>> DEFAULT_CONFIG; // the standard starting position
     Game();
     std::vector<std::vector<char>> config;
+    std::string setupFEN; // from the setup fen command; cleared when the setup is edited by hand
     double getWhiteWins();
     double getBlackWins();
     void incrementWhiteWins(double value);
@@ -28,11 +32,17 @@ class Game {
     Player *getWhitePlayer();
     Player *getBlackPlayer();
     Board *getBoard();
+    Search &getSearch();
     std::vector<Move> getBlackMoves();
     std::vector<Move> getWhiteMoves();
+    std::span<const PackedMove> getBlackMoveList();
+    std::span<const PackedMove> getWhiteMoveList();
     void start(std::string player1, std::string player2, Colour colour);
     bool isSetupValid();
+    bool setupFromFEN(const std::string &fen, Colour &turn); // fills config and turn; false if fen is malformed
+    BitPosition getSetupPosition(Colour turn) const;
     bool gameMove();
+    bool undoMove();
 };
 
 #endif
@@ -21,10 +21,29 @@ Move HumanPlayer::getMove(Board *board) const {
     cin >> col2;
     cin >> row2;
 
-    Position from{row1, col1};
-    Position to{row2, col2};
+    // Rows are read as characters; convert the digit to its rank
+    Position from{row1 - '0', col1};
+    Position to{row2 - '0', col2};
+
+    // Optional promotion piece after the squares, e.g. move e7 e8 n
+    string rest;
+    getline(cin, rest);
+    istringstream iss{rest};
+    char promo = 'q';
+    iss >> promo;
+
+    PieceType promotion = PieceType::NONE;
+    if(board->getGrid()[from.getRowVector()][from.getColVector()].getPieceType() == PieceType::PAWN &&
+       (to.getRow() == 1 || to.getRow() == 8)) {
+        switch(tolower(promo)){
+            case 'n': promotion = PieceType::KNIGHT; break;
+            case 'b': promotion = PieceType::BISHOP; break;
+            case 'r': promotion = PieceType::ROOK; break;
+            default:  promotion = PieceType::QUEEN; break;
+        }
+    }
 
     PieceType pt = board->getGrid()[to.getRowVector()][to.getColVector()].getPieceType();
-    Move mv{from, to, pt};
+    Move mv{from, to, pt, promotion};
     return mv;
 }
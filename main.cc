@@ -2,8 +2,17 @@
 #include <memory>
 #include <string>
 #include <vector>
+#include <chrono>
+#include <new>
+#include <thread>
+#include <algorithm>
 #include "game.h"
 #include "timer.h"
+#include "bitboard.h"
+#include "zobrist.h"
+#include "perft.h"
+#include "bench.h"
+#include "nnue.h"
 
 using namespace std;
 
@@ -20,11 +29,32 @@ void printConfig(const vector<vector<char>> &config) {
 
 int main(int argc, char* argv[]){
     bool enableBonus = false;
+    std::string perftSuiteFile;
+    int cellBenchPlies = 0;
+    int searchBenchDepth = 0;
+    std::string evalBenchNetwork;
+    std::string networkFile;
+    int searchThreads = 1;
+    SearchFeatures searchFeatures;
 
     for (int i = 1; i < argc; ++i) { // start at 1 to skip the program name
         std::string arg = argv[i];
         if (arg == "-enableBonus") {
             enableBonus = true;
+        } else if (arg == "-perftSuite" && i + 1 < argc) {
+            perftSuiteFile = argv[++i];
+        } else if (arg == "-cellBench" && i + 1 < argc) {
+            cellBenchPlies = std::stoi(argv[++i]);
+        } else if (arg == "-searchBench" && i + 1 < argc) {
+            searchBenchDepth = std::stoi(argv[++i]);
+        } else if (arg == "-evalBench" && i + 1 < argc) {
+            evalBenchNetwork = argv[++i];
+        } else if (arg == "-nnue" && i + 1 < argc) {
+            networkFile = argv[++i];
+        } else if (arg == "-threads" && i + 1 < argc) {
+            searchThreads = std::max(1, std::stoi(argv[++i]));
+        } else if (arg == "-off" && i + 1 < argc) {
+            if (!searchFeatures.set(argv[++i], false)) std::cerr << "Unknown search feature " << argv[i] << std::endl;
         }
     }
 
@@ -32,6 +62,33 @@ int main(int argc, char* argv[]){
         std::cout << "Bonus features enabled.\n";
     }
     
+    initBitboards();
+    initZobrist();
+
+    // Non-interactive move generator check, used by make perft-suite
+    if (!perftSuiteFile.empty()) {
+        return runPerftSuite(perftSuiteFile, cout) == 0 ? 0 : 1;
+    }
+    if (cellBenchPlies > 0) {
+        runCellBench(Game::DEFAULT_CONFIG, cellBenchPlies, cout);
+        return 0;
+    }
+    if (!evalBenchNetwork.empty()) {
+        runEvalBench(evalBenchNetwork, cout);
+        return 0;
+    }
+    if (!networkFile.empty()) {
+        std::string error;
+        if (!loadNetwork(networkFile, error)) std::cerr << "Network not loaded: " << error << std::endl;
+    }
+    if (searchBenchDepth > 0) {
+        Search search;
+        search.setThreads(searchThreads);
+        search.setFeatures(searchFeatures);
+        runSearchBench(search, searchBenchDepth, cout);
+        return 0;
+    }
+
     Game game;
     Colour colour = Colour::WHITE;
     unique_ptr<Timer> timer = nullptr;
@@ -48,6 +105,7 @@ int main(int argc, char* argv[]){
     cout << "  - computer1 (Beginner)" << endl;
     cout << "  - computer2 (Intermediate)" << endl;
     cout << "  - computer3 (Advanced)" << endl;
+    cout << "  - computer4 (Search)" << endl;
     cout << "--------------------------------------------------" << endl;
     cout << "To enter setup mode, type:" << endl;
     cout << "  setup" << endl;
@@ -90,9 +148,9 @@ int main(int argc, char* argv[]){
             }
 
             if ((whitePlayer == "human" || whitePlayer == "computer1" || whitePlayer == "computer2" || 
-                whitePlayer == "computer3") && (blackPlayer == "human" ||
+                whitePlayer == "computer3" || whitePlayer == "computer4") && (blackPlayer == "human" ||
                 blackPlayer == "computer1" || blackPlayer == "computer2" || 
-                blackPlayer == "computer3")) {
+                blackPlayer == "computer3" || blackPlayer == "computer4")) {
                     cout << endl;
                 game.start(whitePlayer, blackPlayer, colour);
             } else {
@@ -131,6 +189,7 @@ int main(int argc, char* argv[]){
                 cout << "Enter a command: " << endl;
                 cout << "Your choices are: " << endl;
                 cout << "move <from> <to>" << endl;
+                cout << "undo" << endl;
                 cout << "resign" << endl;
                 cout << "To see the current score: Ctrl + D" << endl;
                 cout << "--------------------------------------------------" << endl;
@@ -198,6 +257,13 @@ int main(int argc, char* argv[]){
                         cout << "Invalid move, try again" << endl;
                         continue;
                     }  
+                } else if (game_cmd == "undo"){
+                    if(game.undoMove()){
+                        if(enableBonus && timer) timer->switchTurn();
+                    } else {
+                        cout << "No moves to undo" << endl;
+                    }
+                    continue;
                 } else if (game_cmd == "resign"){
                     if(enableBonus && timer) timer->stop();
                     if(game.getCurrentTurn()->getColour() == Colour::WHITE){
@@ -226,6 +292,7 @@ int main(int argc, char* argv[]){
             cout << "+ <piece> <position>" << endl;
             cout << "- <position>" << endl;
             cout << "= <colour>" << endl;
+            cout << "fen <FEN string>" << endl;
             cout << "done" << endl;
             cout << "To see the current score: Ctrl + D" << endl;
             cout << "--------------------------------------------------" << endl;
@@ -274,6 +341,7 @@ int main(int argc, char* argv[]){
                             int colIndex = pos.getColVector();
 
                             game.config[rowIndex][colIndex] = piece;
+                            game.setupFEN.clear();
                             printConfig(game.config);
                             cout << "Piece" << piece << " placed at " << position << endl;
                         } else {
@@ -307,6 +375,7 @@ int main(int argc, char* argv[]){
                         } else {
                             game.config[rowIndex][colIndex] = ' ';
                         }
+                        game.setupFEN.clear();
                         printConfig(game.config);
                         cout << "Piece removed from " << position << endl;
                     } else {
@@ -328,10 +397,20 @@ int main(int argc, char* argv[]){
                         } else {
                             colour = Colour::BLACK;
                         }
+                        game.setupFEN.clear();
                         cout << "Current turn set to " << desired_colour << endl;
                     } else {
                         cout << "Invalid Command, colour is not valid" << endl;
                     }
+                } else if (setup_cmd == "fen"){
+                    string fen;
+                    getline(cin, fen);
+                    if (game.setupFromFEN(fen, colour)) {
+                        printConfig(game.config);
+                        cout << "Position loaded, " << (colour == Colour::WHITE ? "white" : "black") << " to move" << endl;
+                    } else {
+                        cout << "Invalid Command, FEN is not valid" << endl;
+                    }
                 } else if (setup_cmd == "done"){
                     if(game.isSetupValid()){
                         cout << "Setup complete!" << endl;
@@ -348,6 +427,119 @@ int main(int argc, char* argv[]){
                 }
             } // while loop for setup
 
+            // perft commands count the move tree from the current setup position
+        } else if (cmd == "perft" || cmd == "divide") {
+            int depth;
+            cin >> depth;
+            if (cin.fail() || depth < 1) {
+                cout << "Invalid Command, depth must be a positive number" << endl;
+                cin.clear();
+                continue;
+            }
+
+            BitPosition pos = game.getSetupPosition(colour);
+            if (cmd == "divide") {
+                perftDivide(pos, depth, cout);
+            } else {
+                auto start = chrono::steady_clock::now();
+                uint64_t nodes = perft(pos, depth);
+                double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+                cout << "Nodes: " << nodes << "  Time: " << static_cast<int>(seconds * 1000) << " ms"
+                     << "  NPS: " << (seconds > 0 ? static_cast<uint64_t>(nodes / seconds) : 0) << endl;
+            }
+            continue;
+
+            // computer4 search limits, kept across games
+        } else if (cmd == "depth" || cmd == "movetime") {
+            int value;
+            cin >> value;
+            if (cin.fail() || value < 0 || (cmd == "depth" && (value < 1 || value > MAX_PLY))) {
+                cout << "Invalid Command, " << cmd << " is out of range" << endl;
+                cin.clear();
+                continue;
+            }
+
+            SearchLimits limits = game.getSearch().getLimits();
+            if (cmd == "depth") limits.depth = value;
+            else limits.moveTimeMs = value;
+            game.getSearch().setLimits(limits);
+            cout << "Search limits: depth " << limits.depth << ", movetime " << limits.moveTimeMs << " ms" << endl;
+            continue;
+
+            // transposition table size for computer4; resizing clears it
+        } else if (cmd == "hash") {
+            int mb;
+            cin >> mb;
+            if (cin.fail() || mb < 1 || mb > 4096) {
+                cout << "Invalid Command, hash size must be between 1 and 4096 MB" << endl;
+                cin.clear();
+                continue;
+            }
+
+            try {
+                game.getSearch().setHashSize(mb);
+            } catch (const bad_alloc &) {
+                cout << "Not enough memory for " << mb << " MB, keeping " << game.getSearch().getHashSize() << " MB" << endl;
+                continue;
+            }
+            cout << "Hash table: " << mb << " MB" << endl;
+            continue;
+
+            // Lazy SMP search threads for computer4
+        } else if (cmd == "threads") {
+            int n;
+            cin >> n;
+            if (cin.fail() || n < 1 || n > MAX_THREADS) {
+                cout << "Invalid Command, threads must be between 1 and " << MAX_THREADS << endl;
+                cin.clear();
+                continue;
+            }
+            game.getSearch().setThreads(n);
+            cout << "Search threads: " << n << " (hardware threads: " << thread::hardware_concurrency() << ")" << endl;
+            continue;
+
+            // network evaluation for computer4: load a weights file, or go back to the hand-crafted one
+        } else if (cmd == "nnue") {
+            string file;
+            cin >> file;
+            if (file == "off") {
+                unloadNetwork();
+                cout << "Evaluation: hand-crafted" << endl;
+                continue;
+            }
+            string error;
+            if (!loadNetwork(file, error)) {
+                cout << "Invalid Command, " << error << endl;
+                continue;
+            }
+            cout << "Evaluation: network " << file << " (" << simdName(getSimdLevel()) << ")" << endl;
+            continue;
+
+            // switch a search technique on or off, to measure it with bench
+        } else if (cmd == "feature") {
+            string name, state;
+            cin >> name >> state;
+            SearchFeatures features = game.getSearch().getFeatures();
+            if ((state != "on" && state != "off") || !features.set(name, state == "on")) {
+                cout << "Invalid Command, usage: feature <name> on|off (" << features.describe() << ")" << endl;
+                continue;
+            }
+            game.getSearch().setFeatures(features);
+            cout << "Search features: " << features.describe() << endl;
+            continue;
+
+            // fixed-depth search over the bench positions with the current threads and hash
+        } else if (cmd == "bench") {
+            int depth;
+            cin >> depth;
+            if (cin.fail() || depth < 1 || depth > MAX_PLY) {
+                cout << "Invalid Command, depth must be a positive number" << endl;
+                cin.clear();
+                continue;
+            }
+            runSearchBench(game.getSearch(), depth, cout);
+            continue;
+
             // help command
         } else if (cmd == "help") {
             cout << "--------------------------------------------------" << endl;
@@ -360,6 +552,7 @@ int main(int argc, char* argv[]){
             cout << "      - computer1 (Beginner)" << endl;
             cout << "      - computer2 (Intermediate)" << endl;
             cout << "      - computer3 (Advanced)" << endl;
+            cout << "      - computer4 (Search, see depth and movetime)" << endl;
             cout << endl;
             cout << "To enter setup mode (customize the board):" << endl;
             cout << "  setup" << endl;
@@ -367,14 +560,26 @@ int main(int argc, char* argv[]){
             cout << "    + <piece> <position>   (add a piece, e.g., + K e1)" << endl;
             cout << "    - <position>           (remove a piece, e.g., - e1)" << endl;
             cout << "    = <colour>             (set whose turn, e.g., = white)" << endl;
+            cout << "    fen <FEN string>       (load a position, e.g., fen 8/8/8/8/8/8/8/K6k w - - 0 1)" << endl;
             cout << "    done                   (finish setup mode)" << endl;
             cout << endl;
             cout << "During a game, you can use:" << endl;
             cout << "  move <from> <to>         (move a piece, e.g., move e2 e4)" << endl;
+            cout << "  move <from> <to> <piece> (promote to q, r, b or n, e.g., move e7 e8 n)" << endl;
+            cout << "  undo                     (take back the last move)" << endl;
             cout << "  resign                   (concede the game)" << endl;
             cout << endl;
             cout << "At any time, you can use:" << endl;
             cout << "  help                     (to get help)" << endl;
+            cout << "  perft <depth>            (count positions reachable from the setup position)" << endl;
+            cout << "  divide <depth>           (perft split by first move)" << endl;
+            cout << "  depth <n>                (deepest search iteration for computer4, e.g., depth 8)" << endl;
+            cout << "  movetime <ms>            (computer4 thinking time per move, 0 for no limit)" << endl;
+            cout << "  hash <MB>                (computer4 transposition table size, e.g., hash 64)" << endl;
+            cout << "  threads <n>              (computer4 search threads, e.g., threads 8)" << endl;
+            cout << "  nnue <file>|off          (evaluate with a HalfKP network file, or the hand-crafted one)" << endl;
+            cout << "  feature <name> on|off    (switch a search technique, e.g., feature pvs off)" << endl;
+            cout << "  bench <depth>            (search the benchmark positions to a fixed depth)" << endl;
             cout << "--------------------------------------------------" << endl;
             continue;
         } else {
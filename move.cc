@@ -2,10 +2,10 @@
 
 // Default constructor - creates invalid move
 Move::Move()
-    : from{Position{-1,'@'}}, to{Position{-1,'@'}}, pieceCaptured{PieceType::NONE} {}
+    : from{Position{-1,'@'}}, to{Position{-1,'@'}}, pieceCaptured{PieceType::NONE}, promotion{PieceType::NONE} {}
 
-Move::Move(Position from, Position to, PieceType pieceCaptured)
-     : from{from}, to{to}, pieceCaptured{pieceCaptured} {}
+Move::Move(Position from, Position to, PieceType pieceCaptured, PieceType promotion)
+     : from{from}, to{to}, pieceCaptured{pieceCaptured}, promotion{promotion} {}
 
 Position Move::getFrom() const {
     return from;
@@ -19,10 +19,14 @@ PieceType Move::getPieceType() {
     return pieceCaptured;
 }
 
+PieceType Move::getPromotion() const {
+    return promotion;
+}
+
 bool Move::isCaptured() {
     return (pieceCaptured != PieceType::NONE);
 }
 
 bool Move::operator==(const Move& other) const{
-   return (from == other.from && to == other.to && pieceCaptured == other.pieceCaptured);
+   return (from == other.from && to == other.to && pieceCaptured == other.pieceCaptured && promotion == other.promotion);
 }
@@ -7,13 +7,15 @@ class Move {
     Position from;
     Position to;
     PieceType pieceCaptured;
+    PieceType promotion; // piece a pawn becomes, NONE if not a promotion
 
     public:
     Move(); // Default constructor that creates an invalid move
-    Move(Position from, Position to, PieceType pieceCaptured);
+    Move(Position from, Position to, PieceType pieceCaptured, PieceType promotion = PieceType::NONE);
     Position getFrom() const;
     Position getTo() const;
     PieceType getPieceType();
+    PieceType getPromotion() const;
     bool isCaptured();
     bool operator==(const Move& other) const;
 };
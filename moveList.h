@@ -0,0 +1,41 @@
+#ifndef MOVELIST_H
+#define MOVELIST_H
+#include "packedMove.h"
+#include <span>
+
+// Fixed-capacity move list stored inline, so generating moves never touches the heap.
+// 256 is above the largest number of legal moves in any reachable chess position (218).
+class MoveList {
+  public:
+    static const int MAX_MOVES = 256;
+
+  private:
+    PackedMove moves[MAX_MOVES];
+    int count = 0;
+
+  public:
+    void add(PackedMove mv) { moves[count++] = mv; }
+    void add(int from, int to, int flags = PackedMove::QUIET) { moves[count++] = PackedMove{from, to, flags}; }
+    void clear() { count = 0; }
+
+    int size() const { return count; }
+    bool empty() const { return count == 0; }
+    PackedMove operator[](int i) const { return moves[i]; }
+    PackedMove &operator[](int i) { return moves[i]; }
+
+    const PackedMove *begin() const { return moves; }
+    const PackedMove *end() const { return moves + count; }
+    PackedMove *begin() { return moves; }
+    PackedMove *end() { return moves + count; }
+
+    std::span<const PackedMove> view() const { return {moves, static_cast<std::size_t>(count)}; }
+
+    bool contains(PackedMove mv) const {
+        for (int i = 0; i < count; ++i) {
+            if (moves[i] == mv) return true;
+        }
+        return false;
+    }
+};
+
+#endif
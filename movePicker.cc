@@ -0,0 +1,100 @@
+#include "movePicker.h"
+#include "evaluate.h"
+#include "see.h"
+#include <cstdlib>
+
+using namespace std;
+
+void ButterflyHistory::update(Colour colour, PackedMove mv, int bonus) {
+    int &entry = table[colourIndex(colour)][mv.getFrom()][mv.getTo()];
+    entry += bonus - entry * abs(bonus) / MAX_SCORE; // pulls towards zero as the entry grows, so it stays in range
+}
+
+MovePicker::MovePicker(const BitPosition &pos, PackedMove ttMove, const PackedMove killers[2], const ButterflyHistory &history)
+    : pos{pos}, history{&history}, ttMove{ttMove}, killers{killers[0], killers[1]}, skipQuiets{false} {
+    stage = (!ttMove.isNone() && pos.isLegal(ttMove)) ? Stage::TT_MOVE : Stage::GEN_CAPTURES;
+    if (stage == Stage::GEN_CAPTURES) this->ttMove = PackedMove{};
+}
+
+MovePicker::MovePicker(const BitPosition &pos)
+    : pos{pos}, history{nullptr}, stage{Stage::GEN_CAPTURES}, skipQuiets{true} {}
+
+PackedMove MovePicker::pickBest() {
+    int best = current;
+    for (int i = current + 1; i < moves.size(); ++i) {
+        if (scores[i] > scores[best]) best = i;
+    }
+    swap(moves[current], moves[best]);
+    swap(scores[current], scores[best]);
+    return moves[current++];
+}
+
+PackedMove MovePicker::next() {
+    switch (stage) {
+        case Stage::TT_MOVE:
+            stage = Stage::GEN_CAPTURES;
+            return ttMove;
+
+        case Stage::GEN_CAPTURES:
+            pos.generateLegalCaptures(moves);
+            for (int i = 0; i < moves.size(); ++i) {
+                PackedMove mv = moves[i];
+                PieceType victim = mv.isEnPassant() ? PieceType::PAWN : pos.pieceTypeOn(mv.getTo());
+                scores[i] = (victim == PieceType::NONE ? 0 : 10 * PIECE_VALUES[pieceIndex(victim)])
+                          - PIECE_VALUES[pieceIndex(pos.pieceTypeOn(mv.getFrom()))];
+                if (mv.isPromotion()) scores[i] += PIECE_VALUES[pieceIndex(mv.getPromotion())];
+            }
+            current = 0;
+            stage = Stage::GOOD_CAPTURES;
+            [[fallthrough]];
+
+        case Stage::GOOD_CAPTURES:
+            while (current < moves.size()) {
+                PackedMove mv = pickBest();
+                if (mv == ttMove) continue;
+                if (see(pos, mv) < 0) {
+                    badCaptures.add(mv); // kept for last; quiescence drops them
+                    continue;
+                }
+                return mv;
+            }
+            if (skipQuiets) {
+                stage = Stage::DONE;
+                return PackedMove{};
+            }
+            stage = Stage::KILLERS;
+            [[fallthrough]];
+
+        case Stage::KILLERS:
+            while (killerIndex < 2) {
+                PackedMove mv = killers[killerIndex++];
+                if (!mv.isNone() && mv != ttMove && !mv.isCapture() && !mv.isPromotion() && pos.isLegal(mv)) return mv;
+            }
+            stage = Stage::GEN_QUIETS;
+            [[fallthrough]];
+
+        case Stage::GEN_QUIETS:
+            pos.generateLegalQuiets(moves);
+            for (int i = 0; i < moves.size(); ++i) scores[i] = history->get(pos.getSideToMove(), moves[i]);
+            current = 0;
+            stage = Stage::QUIETS;
+            [[fallthrough]];
+
+        case Stage::QUIETS:
+            while (current < moves.size()) {
+                PackedMove mv = pickBest();
+                if (!isSpecial(mv)) return mv;
+            }
+            stage = Stage::BAD_CAPTURES;
+            [[fallthrough]];
+
+        case Stage::BAD_CAPTURES:
+            if (badCurrent < badCaptures.size()) return badCaptures[badCurrent++];
+            stage = Stage::DONE;
+            [[fallthrough]];
+
+        case Stage::DONE:
+            return PackedMove{};
+    }
+    return PackedMove{};
+}
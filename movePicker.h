@@ -0,0 +1,55 @@
+#ifndef MOVEPICKER_H
+#define MOVEPICKER_H
+#include "bitPosition.h"
+
+// Butterfly history: how often a quiet move from one square to another has caused a beta cutoff,
+// per side, decayed so that recent results count most
+class ButterflyHistory {
+    int table[2][NUM_SQUARES][NUM_SQUARES] = {};
+
+  public:
+    static const int MAX_SCORE = 16384;
+
+    int get(Colour colour, PackedMove mv) const { return table[colourIndex(colour)][mv.getFrom()][mv.getTo()]; }
+    void update(Colour colour, PackedMove mv, int bonus); // bonus may be negative
+    void clear() { *this = ButterflyHistory{}; }
+};
+
+// Hands out the legal moves of a position one at a time, best guesses first, generating each
+// group only when the previous ones are used up. A beta cutoff on the hash move or a capture
+// therefore never pays for generating the quiet moves.
+//   1. the hash move
+//   2. captures and promotions that do not lose material (static exchange), by MVV-LVA
+//   3. the two killer moves of this ply
+//   4. the other quiet moves, by butterfly history
+//   5. the captures that lose material
+class MovePicker {
+    enum class Stage { TT_MOVE, GEN_CAPTURES, GOOD_CAPTURES, KILLERS, GEN_QUIETS, QUIETS, BAD_CAPTURES, DONE };
+
+    const BitPosition &pos;
+    const ButterflyHistory *history;
+    PackedMove ttMove;
+    PackedMove killers[2];
+    Stage stage;
+    bool skipQuiets;   // quiescence: stop after the good captures
+
+    MoveList moves;
+    int scores[MoveList::MAX_MOVES];
+    int current = 0;
+    int killerIndex = 0;
+    MoveList badCaptures;
+    int badCurrent = 0;
+
+    PackedMove pickBest(); // best remaining move of moves by score, selection sort style
+    bool isSpecial(PackedMove mv) const { return mv == ttMove || mv == killers[0] || mv == killers[1]; }
+
+  public:
+    // Main search: every legal move
+    MovePicker(const BitPosition &pos, PackedMove ttMove, const PackedMove killers[2], const ButterflyHistory &history);
+    // Quiescence: only captures and promotions that do not lose material
+    explicit MovePicker(const BitPosition &pos);
+
+    PackedMove next(); // none once every move has been handed out
+};
+
+#endif
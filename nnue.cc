@@ -0,0 +1,320 @@
+#include "nnue.h"
+#include "bitPosition.h"
+#include <algorithm>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define NNUE_X86 1
+#endif
+
+using namespace std;
+
+uint32_t nnueVersion = 0;
+
+// Network scores are kept clear of the mate range
+const int MAX_NETWORK_SCORE = 30000;
+const size_t HEADER_SIZE = 64;
+
+// The loaded network: pointers into the mapped file
+struct Network {
+    void *mapping = nullptr;
+    size_t mappingSize = 0;
+    const int16_t *featureBias = nullptr;
+    const int16_t *featureWeights = nullptr;
+    const int16_t *outputWeights = nullptr;
+    int32_t outputBias = 0;
+};
+
+static Network network;
+static uint32_t lastVersion = 0; // versions are never reused, so no stale accumulator can match
+
+// Scalar kernels: the reference every vector version must agree with exactly
+
+static void addRowScalar(int16_t *acc, const int16_t *row) {
+    for (int i = 0; i < NNUE_HIDDEN; ++i) acc[i] += row[i];
+}
+
+static void subRowScalar(int16_t *acc, const int16_t *row) {
+    for (int i = 0; i < NNUE_HIDDEN; ++i) acc[i] -= row[i];
+}
+
+static int32_t outputScalar(const int16_t *us, const int16_t *them, const int16_t *weights) {
+    int32_t sum = 0;
+    for (int i = 0; i < NNUE_HIDDEN; ++i) {
+        sum += clamp<int32_t>(us[i], 0, NNUE_QA) * weights[i];
+        sum += clamp<int32_t>(them[i], 0, NNUE_QA) * weights[NNUE_HIDDEN + i];
+    }
+    return sum;
+}
+
+#ifdef NNUE_X86
+// Compiled for their instruction sets with target attributes, so the rest of the program stays
+// portable and the choice is made at run time
+
+__attribute__((target("sse4.1"))) static void addRowSse(int16_t *acc, const int16_t *row) {
+    for (int i = 0; i < NNUE_HIDDEN; i += 8) {
+        __m128i *a = reinterpret_cast<__m128i *>(acc + i);
+        _mm_store_si128(a, _mm_add_epi16(_mm_load_si128(a), _mm_loadu_si128(reinterpret_cast<const __m128i *>(row + i))));
+    }
+}
+
+__attribute__((target("sse4.1"))) static void subRowSse(int16_t *acc, const int16_t *row) {
+    for (int i = 0; i < NNUE_HIDDEN; i += 8) {
+        __m128i *a = reinterpret_cast<__m128i *>(acc + i);
+        _mm_store_si128(a, _mm_sub_epi16(_mm_load_si128(a), _mm_loadu_si128(reinterpret_cast<const __m128i *>(row + i))));
+    }
+}
+
+__attribute__((target("sse4.1"))) static int32_t outputSse(const int16_t *us, const int16_t *them, const int16_t *weights) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i qa = _mm_set1_epi16(NNUE_QA);
+    __m128i sum = zero;
+    for (int half = 0; half < 2; ++half) {
+        const int16_t *acc = half == 0 ? us : them;
+        const int16_t *w = weights + half * NNUE_HIDDEN;
+        for (int i = 0; i < NNUE_HIDDEN; i += 8) {
+            __m128i v = _mm_min_epi16(_mm_max_epi16(_mm_load_si128(reinterpret_cast<const __m128i *>(acc + i)), zero), qa);
+            sum = _mm_add_epi32(sum, _mm_madd_epi16(v, _mm_loadu_si128(reinterpret_cast<const __m128i *>(w + i))));
+        }
+    }
+    return _mm_extract_epi32(sum, 0) + _mm_extract_epi32(sum, 1) + _mm_extract_epi32(sum, 2) + _mm_extract_epi32(sum, 3);
+}
+
+__attribute__((target("avx2"))) static void addRowAvx2(int16_t *acc, const int16_t *row) {
+    for (int i = 0; i < NNUE_HIDDEN; i += 16) {
+        __m256i *a = reinterpret_cast<__m256i *>(acc + i);
+        _mm256_store_si256(a, _mm256_add_epi16(_mm256_load_si256(a), _mm256_loadu_si256(reinterpret_cast<const __m256i *>(row + i))));
+    }
+}
+
+__attribute__((target("avx2"))) static void subRowAvx2(int16_t *acc, const int16_t *row) {
+    for (int i = 0; i < NNUE_HIDDEN; i += 16) {
+        __m256i *a = reinterpret_cast<__m256i *>(acc + i);
+        _mm256_store_si256(a, _mm256_sub_epi16(_mm256_load_si256(a), _mm256_loadu_si256(reinterpret_cast<const __m256i *>(row + i))));
+    }
+}
+
+__attribute__((target("avx2"))) static int32_t outputAvx2(const int16_t *us, const int16_t *them, const int16_t *weights) {
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i qa = _mm256_set1_epi16(NNUE_QA);
+    __m256i sum = zero;
+    for (int half = 0; half < 2; ++half) {
+        const int16_t *acc = half == 0 ? us : them;
+        const int16_t *w = weights + half * NNUE_HIDDEN;
+        for (int i = 0; i < NNUE_HIDDEN; i += 16) {
+            __m256i v = _mm256_min_epi16(_mm256_max_epi16(_mm256_load_si256(reinterpret_cast<const __m256i *>(acc + i)), zero), qa);
+            sum = _mm256_add_epi32(sum, _mm256_madd_epi16(v, _mm256_loadu_si256(reinterpret_cast<const __m256i *>(w + i))));
+        }
+    }
+    __m128i s = _mm_add_epi32(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1));
+    s = _mm_add_epi32(s, _mm_shuffle_epi32(s, _MM_SHUFFLE(1, 0, 3, 2)));
+    s = _mm_add_epi32(s, _mm_shuffle_epi32(s, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_cvtsi128_si32(s);
+}
+#endif
+
+struct Kernels {
+    void (*addRow)(int16_t *, const int16_t *);
+    void (*subRow)(int16_t *, const int16_t *);
+    int32_t (*output)(const int16_t *, const int16_t *, const int16_t *);
+};
+
+static Kernels kernelsFor(SimdLevel level) {
+#ifdef NNUE_X86
+    if (level == SimdLevel::AVX2) return {addRowAvx2, subRowAvx2, outputAvx2};
+    if (level == SimdLevel::SSE41) return {addRowSse, subRowSse, outputSse};
+#endif
+    return {addRowScalar, subRowScalar, outputScalar};
+}
+
+SimdLevel detectSimd() {
+#ifdef NNUE_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) return SimdLevel::AVX2;
+    if (__builtin_cpu_supports("sse4.1")) return SimdLevel::SSE41;
+#endif
+    return SimdLevel::SCALAR;
+}
+
+static SimdLevel simdLevel = detectSimd();
+static Kernels kernels = kernelsFor(simdLevel);
+
+SimdLevel getSimdLevel() {
+    return simdLevel;
+}
+
+void setSimdLevel(SimdLevel level) {
+    simdLevel = min(level, detectSimd());
+    kernels = kernelsFor(simdLevel);
+}
+
+const char *simdName(SimdLevel level) {
+    switch (level) {
+        case SimdLevel::AVX2:  return "avx2";
+        case SimdLevel::SSE41: return "sse4.1";
+        default:               return "scalar";
+    }
+}
+
+bool loadNetwork(const string &path, string &error) {
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        error = "cannot open " + path;
+        return false;
+    }
+    struct stat info;
+    size_t expected = HEADER_SIZE + sizeof(int16_t) * (NNUE_HIDDEN + size_t{NNUE_INPUTS} * NNUE_HIDDEN + 2 * NNUE_HIDDEN)
+                    + sizeof(int32_t);
+    if (fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) != expected) {
+        close(fd);
+        error = path + " is not a " + to_string(expected) + " byte network";
+        return false;
+    }
+    void *mapping = mmap(nullptr, expected, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd); // the mapping stays valid without the descriptor
+    if (mapping == MAP_FAILED) {
+        error = "cannot map " + path;
+        return false;
+    }
+
+    const char *bytes = static_cast<const char *>(mapping);
+    uint32_t inputs, hidden;
+    memcpy(&inputs, bytes + 4, sizeof(inputs));
+    memcpy(&hidden, bytes + 8, sizeof(hidden));
+    if (memcmp(bytes, "HKP1", 4) != 0 || inputs != NNUE_INPUTS || hidden != NNUE_HIDDEN) {
+        munmap(mapping, expected);
+        error = path + " has the wrong header or dimensions";
+        return false;
+    }
+
+    unloadNetwork();
+    network.mapping = mapping;
+    network.mappingSize = expected;
+    network.featureBias = reinterpret_cast<const int16_t *>(bytes + HEADER_SIZE);
+    network.featureWeights = network.featureBias + NNUE_HIDDEN;
+    network.outputWeights = network.featureWeights + size_t{NNUE_INPUTS} * NNUE_HIDDEN;
+    memcpy(&network.outputBias, network.outputWeights + 2 * NNUE_HIDDEN, sizeof(network.outputBias));
+    nnueVersion = ++lastVersion;
+    return true;
+}
+
+void unloadNetwork() {
+    if (network.mapping) munmap(network.mapping, network.mappingSize);
+    network = Network{};
+    nnueVersion = 0;
+}
+
+bool networkLoaded() {
+    return nnueVersion != 0;
+}
+
+// Feature of a piece seen from one side, whose king is on kingSq. Black's view is flipped
+// vertically, so "own pieces on the home rank" mean the same thing to both sides.
+static int featureIndex(Colour perspective, int kingSq, Colour colour, PieceType pt, int sq) {
+    int flip = perspective == Colour::WHITE ? 0 : 56;
+    int kind = pieceIndex(pt) - 1 + (colour == perspective ? 0 : NNUE_KINDS / 2); // kings are not features
+    return ((kingSq ^ flip) * NNUE_KINDS + kind) * NUM_SQUARES + (sq ^ flip);
+}
+
+static const int16_t *featureRow(int feature) {
+    return network.featureWeights + size_t(feature) * NNUE_HIDDEN;
+}
+
+// Recomputes one side's sums from the bias and every non-king piece on the board
+static void refresh(NnueAccumulator &acc, const BitPosition &pos, Colour perspective) {
+    int p = colourIndex(perspective);
+    int kingSq = pos.kingSquare(perspective);
+    memcpy(acc.values[p], network.featureBias, sizeof(acc.values[p]));
+    for (Colour colour : {Colour::WHITE, Colour::BLACK}) {
+        for (int pt = pieceIndex(PieceType::QUEEN); pt <= pieceIndex(PieceType::PAWN); ++pt) {
+            PieceType type = static_cast<PieceType>(pt);
+            for (Bitboard b = pos.getPieces(colour, type); b; b &= b - 1)
+                kernels.addRow(acc.values[p], featureRow(featureIndex(perspective, kingSq, colour, type, lsb(b))));
+        }
+    }
+    acc.version[p] = nnueVersion;
+}
+
+// One side's sums from the parent's and the pieces the move changed; kingSq is that side's king,
+// which the move did not touch
+static void update(NnueAccumulator &acc, const NnueAccumulator &parent, Colour perspective, int kingSq) {
+    int p = colourIndex(perspective);
+    memcpy(acc.values[p], parent.values[p], sizeof(acc.values[p]));
+    for (int i = 0; i < acc.removedCount; ++i) {
+        const NnuePiece &piece = acc.removed[i];
+        kernels.subRow(acc.values[p], featureRow(featureIndex(perspective, kingSq, piece.colour, piece.pt, piece.sq)));
+    }
+    for (int i = 0; i < acc.addedCount; ++i) {
+        const NnuePiece &piece = acc.added[i];
+        kernels.addRow(acc.values[p], featureRow(featureIndex(perspective, kingSq, piece.colour, piece.pt, piece.sq)));
+    }
+    acc.version[p] = nnueVersion;
+}
+
+NnueStack::NnueStack(int size) : plies{make_unique<NnueAccumulator[]>(size)} {}
+
+void NnueStack::reset() {
+    plies[0].version[0] = plies[0].version[1] = 0;
+}
+
+void NnueStack::recordMove(int ply, const BitPosition &before, PackedMove mv) {
+    NnueAccumulator &acc = plies[ply];
+    Colour us = before.getSideToMove();
+    Colour them = opposite(us);
+    int from = mv.getFrom();
+    int to = mv.getTo();
+    PieceType moved = before.pieceTypeOn(from);
+
+    acc.version[0] = acc.version[1] = 0;
+    acc.kingMoved[colourIndex(us)] = moved == PieceType::KING;
+    acc.kingMoved[colourIndex(them)] = false;
+    acc.removedCount = acc.addedCount = 0;
+
+    if (mv.isCastle()) {
+        bool kingSide = mv.getFlags() == PackedMove::KING_CASTLE;
+        acc.removed[acc.removedCount++] = {us, PieceType::ROOK, kingSide ? to + 1 : to - 2};
+        acc.added[acc.addedCount++] = {us, PieceType::ROOK, kingSide ? to - 1 : to + 1};
+        return;
+    }
+    if (mv.isEnPassant()) acc.removed[acc.removedCount++] = {them, PieceType::PAWN, us == Colour::WHITE ? to - 8 : to + 8};
+    else if (before.pieceTypeOn(to) != PieceType::NONE) acc.removed[acc.removedCount++] = {them, before.pieceTypeOn(to), to};
+    if (moved != PieceType::KING) {
+        acc.removed[acc.removedCount++] = {us, moved, from};
+        acc.added[acc.addedCount++] = {us, mv.isPromotion() ? mv.getPromotion() : moved, to};
+    }
+}
+
+void NnueStack::recordNullMove(int ply) {
+    NnueAccumulator &acc = plies[ply];
+    acc.version[0] = acc.version[1] = 0;
+    acc.kingMoved[0] = acc.kingMoved[1] = false;
+    acc.removedCount = acc.addedCount = 0;
+}
+
+int NnueStack::evaluate(const BitPosition &pos, int ply) {
+    NnueAccumulator &acc = plies[ply];
+    for (Colour perspective : {Colour::WHITE, Colour::BLACK}) {
+        int p = colourIndex(perspective);
+        if (acc.version[p] == nnueVersion) continue;
+
+        // Back to the nearest ply with this side's sums, unless its king moved on the way
+        int base = ply;
+        while (base > 0 && plies[base].version[p] != nnueVersion && !plies[base].kingMoved[p]) --base;
+        if (plies[base].version[p] != nnueVersion) {
+            refresh(acc, pos, perspective);
+            continue;
+        }
+        int kingSq = pos.kingSquare(perspective);
+        for (int i = base + 1; i <= ply; ++i) update(plies[i], plies[i - 1], perspective, kingSq);
+    }
+
+    Colour us = pos.getSideToMove();
+    int64_t sum = network.outputBias
+                + kernels.output(acc.values[colourIndex(us)], acc.values[colourIndex(opposite(us))], network.outputWeights);
+    int score = static_cast<int>(sum * NNUE_SCALE / (NNUE_QA * NNUE_QB));
+    return clamp(score, -MAX_NETWORK_SCORE, MAX_NETWORK_SCORE);
+}
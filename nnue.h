@@ -0,0 +1,86 @@
+#ifndef NNUE_H
+#define NNUE_H
+#include "enumerated.h"
+#include "packedMove.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+
+// A small HalfKP network evaluator.
+//
+// Inputs: for each side's point of view, one feature per (own king square, non-king piece,
+// square), with black's view mirrored so both sides see the board from their own first rank.
+// Those features feed NNUE_HIDDEN int16 sums per side (the accumulator). A search keeps one per ply
+// and derives each from its parent's by the few pieces the move changed, so only a king move forces
+// recomputing one side from scratch, and taking a move back costs nothing.
+// The output is a clipped ReLU of both sums (side to move first) dotted with the output weights.
+//
+// Weights are read in place from a memory-mapped file, little endian:
+//   64-byte header: "HKP1", uint32 inputs (NNUE_INPUTS), uint32 hidden (NNUE_HIDDEN), zero padding
+//   int16 featureBias[NNUE_HIDDEN]
+//   int16 featureWeights[NNUE_INPUTS][NNUE_HIDDEN]
+//   int16 outputWeights[2][NNUE_HIDDEN]
+//   int32 outputBias
+// Accumulator values are clipped to [0, NNUE_QA]; the output sum is scaled by
+// NNUE_SCALE / (NNUE_QA * NNUE_QB) to give centipawns.
+
+const int NNUE_KINDS = 10; // queen, bishop, rook, knight, pawn; own then enemy
+const int NNUE_INPUTS = 64 * NNUE_KINDS * 64;
+const int NNUE_HIDDEN = 256;
+const int NNUE_QA = 255;
+const int NNUE_QB = 64;
+const int NNUE_SCALE = 400;
+
+class BitPosition;
+
+// A non-king piece on a square, as the move into a ply added or removed it
+struct NnuePiece {
+    Colour colour;
+    PieceType pt;
+    int sq;
+};
+
+// Both sides' feature sums at one ply, and how the move into that ply changed the pieces. Each
+// half carries the network version it was computed for; 0 (or an old version) means not computed.
+struct NnueAccumulator {
+    alignas(32) std::int16_t values[2][NNUE_HIDDEN];
+    std::uint32_t version[2] = {0, 0};
+    bool kingMoved[2] = {false, false}; // by colourIndex; that side's half cannot come from the parent
+    int removedCount = 0;
+    int addedCount = 0;
+    NnuePiece removed[2]; // a capture and the moving piece, or the castling rook
+    NnuePiece added[1];
+};
+
+// Loaded network version, 0 if none; accumulators compare against it
+extern std::uint32_t nnueVersion;
+
+bool loadNetwork(const std::string &path, std::string &error); // false (old network kept) on failure
+void unloadNetwork();
+bool networkLoaded();
+
+// Vector kernels for the accumulator and output layer, picked at startup from CPUID
+enum class SimdLevel { SCALAR, SSE41, AVX2 };
+SimdLevel detectSimd();           // best level this CPU supports
+SimdLevel getSimdLevel();
+void setSimdLevel(SimdLevel level); // at most detectSimd(); used to compare kernels
+const char *simdName(SimdLevel level);
+
+// One search thread's accumulators, indexed by ply from the root. Making a move only records what
+// it changes in the next ply's entry; the sums are worked out when a node is evaluated, from the
+// nearest ply below it that has them. Callers record moves only while a network is loaded.
+class NnueStack {
+    std::unique_ptr<NnueAccumulator[]> plies;
+
+  public:
+    explicit NnueStack(int size); // plies 0 to size - 1
+    void reset();                 // a new root: ply 0 is computed from the board when needed
+    void recordMove(int ply, const BitPosition &before, PackedMove mv); // mv leads from ply - 1 to ply
+    void recordNullMove(int ply);
+
+    // Network evaluation in centipawns from the side to move's point of view of pos, the position
+    // at ply
+    int evaluate(const BitPosition &pos, int ply);
+};
+
+#endif
@@ -0,0 +1,10 @@
+#include "packedMove.h"
+
+using namespace std;
+
+ostream &operator<<(ostream &out, const PackedMove &mv) {
+    out << char('a' + (mv.getFrom() & 7)) << char('1' + (mv.getFrom() >> 3))
+        << char('a' + (mv.getTo() & 7)) << char('1' + (mv.getTo() >> 3));
+    if (mv.isPromotion()) out << "nbrq"[PackedMove::promotionCode(mv.getPromotion())];
+    return out;
+}
@@ -0,0 +1,70 @@
+#ifndef PACKEDMOVE_H
+#define PACKEDMOVE_H
+#include "enumerated.h"
+#include <cstdint>
+#include <iostream>
+
+// A move packed into 16 bits: bits 0-5 from square, bits 6-11 to square, bits 12-15 flags.
+// The flags say how to play the move, so makeMove never has to inspect the board to find
+// castling, en passant, double pushes or the promotion piece.
+class PackedMove {
+    std::uint16_t data;
+
+  public:
+    // Flag values; bit 2 marks captures and bit 3 marks promotions
+    static constexpr int QUIET = 0;
+    static constexpr int DOUBLE_PUSH = 1;
+    static constexpr int KING_CASTLE = 2;
+    static constexpr int QUEEN_CASTLE = 3;
+    static constexpr int CAPTURE = 4;
+    static constexpr int EN_PASSANT = 5;
+    static constexpr int PROMOTION = 8;          // + 0..3 for knight, bishop, rook, queen
+    static constexpr int PROMOTION_CAPTURE = 12; // + 0..3 likewise
+
+    PackedMove() : data{0} {} // a1a1, never a legal move
+    PackedMove(int from, int to, int flags = QUIET)
+        : data{static_cast<std::uint16_t>(from | (to << 6) | (flags << 12))} {}
+
+    int getFrom() const { return data & 0x3F; }
+    int getTo() const { return (data >> 6) & 0x3F; }
+    int getFlags() const { return data >> 12; }
+    std::uint16_t raw() const { return data; }
+
+    bool isNone() const { return data == 0; }
+    bool isCapture() const { return getFlags() & CAPTURE; }
+    bool isPromotion() const { return getFlags() & PROMOTION; }
+    bool isCastle() const { return getFlags() == KING_CASTLE || getFlags() == QUEEN_CASTLE; }
+    bool isEnPassant() const { return getFlags() == EN_PASSANT; }
+    bool isDoublePush() const { return getFlags() == DOUBLE_PUSH; }
+    PieceType getPromotion() const;
+
+    bool operator==(const PackedMove &other) const { return data == other.data; }
+    bool operator!=(const PackedMove &other) const { return data != other.data; }
+
+    // Promotion flag offset (0..3) for a promotion piece
+    static int promotionCode(PieceType pt);
+};
+
+inline PieceType PackedMove::getPromotion() const {
+    if (!isPromotion()) return PieceType::NONE;
+    switch (getFlags() & 3) {
+        case 0:  return PieceType::KNIGHT;
+        case 1:  return PieceType::BISHOP;
+        case 2:  return PieceType::ROOK;
+        default: return PieceType::QUEEN;
+    }
+}
+
+inline int PackedMove::promotionCode(PieceType pt) {
+    switch (pt) {
+        case PieceType::KNIGHT: return 0;
+        case PieceType::BISHOP: return 1;
+        case PieceType::ROOK:   return 2;
+        default:                return 3;
+    }
+}
+
+// Coordinate notation, e.g. e2e4 or e7e8q
+std::ostream &operator<<(std::ostream &out, const PackedMove &mv);
+
+#endif
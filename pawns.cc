@@ -0,0 +1,104 @@
+#include "pawns.h"
+#include <algorithm>
+
+using namespace std;
+
+// Penalties and bonuses in centipawns, middlegame then endgame
+const int DOUBLED[2] = {-10, -25};
+const int ISOLATED[2] = {-6, -15};
+const int BACKWARD[2] = {-8, -20};
+const int PASSED_MIDGAME[8] = {0, 5, 10, 15, 30, 55, 90, 0};   // by rank from the pawn's own side
+const int PASSED_ENDGAME[8] = {0, 10, 20, 35, 60, 100, 150, 0};
+const int SHELTER_PAWN = 12; // per own pawn on the two ranks in front of a castled-height king
+
+// Squares on the ranks strictly ahead of sq, from colour's side
+static Bitboard ranksAhead(Colour colour, int sq) {
+    return colour == Colour::WHITE ? ~Bitboard{0} << 8 << (8 * rankOf(sq)) : (Bitboard{1} << (8 * rankOf(sq))) - 1;
+}
+
+static Bitboard adjacentFiles(int file) {
+    return (file > 0 ? FILE_A << (file - 1) : 0) | (file < 7 ? FILE_A << (file + 1) : 0);
+}
+
+static void evaluateStructure(const BitPosition &pos, PawnEntry &entry) {
+    entry.midgame = entry.endgame = 0;
+    for (Colour colour : {Colour::WHITE, Colour::BLACK}) {
+        int c = colourIndex(colour);
+        int sign = colour == Colour::WHITE ? 1 : -1;
+        Bitboard ours = pos.getPieces(colour, PieceType::PAWN);
+        Bitboard theirs = pos.getPieces(opposite(colour), PieceType::PAWN);
+        entry.passed[c] = 0;
+
+        for (Bitboard b = ours; b; b &= b - 1) {
+            int sq = lsb(b);
+            int file = fileOf(sq);
+            int rank = colour == Colour::WHITE ? rankOf(sq) : 7 - rankOf(sq);
+            Bitboard ahead = ranksAhead(colour, sq);
+            Bitboard fileMask = FILE_A << file;
+            Bitboard neighbours = adjacentFiles(file);
+            int mg = 0, eg = 0;
+
+            bool doubled = ours & fileMask & ahead; // the rear pawn of a pair takes the penalty
+            bool isolated = !(ours & neighbours);
+            if (doubled) {
+                mg += DOUBLED[0];
+                eg += DOUBLED[1];
+            }
+            if (isolated) {
+                mg += ISOLATED[0];
+                eg += ISOLATED[1];
+            } else {
+                // No friendly pawn level or behind on a neighbouring file can ever defend it, and
+                // an enemy pawn stops it from advancing to catch up
+                int stop = colour == Colour::WHITE ? sq + 8 : sq - 8;
+                if (!(ours & neighbours & ~ahead) && (pawnAttacks[c][stop] & theirs)) {
+                    mg += BACKWARD[0];
+                    eg += BACKWARD[1];
+                }
+            }
+            if (!doubled && !(theirs & (fileMask | neighbours) & ahead)) {
+                entry.passed[c] |= squareBB(sq);
+                mg += PASSED_MIDGAME[rank];
+                eg += PASSED_ENDGAME[rank];
+            }
+            entry.midgame += sign * mg;
+            entry.endgame += sign * eg;
+        }
+    }
+    entry.shelterSquare[0] = entry.shelterSquare[1] = NO_SQUARE;
+}
+
+int PawnEntry::kingShelter(const BitPosition &pos, Colour colour) {
+    int c = colourIndex(colour);
+    int kingSq = pos.kingSquare(colour);
+    if (shelterSquare[c] == kingSq) return shelter[c];
+
+    int rank = colour == Colour::WHITE ? rankOf(kingSq) : 7 - rankOf(kingSq);
+    int bonus = 0;
+    if (rank <= 1) {
+        Bitboard files = (FILE_A << fileOf(kingSq)) | adjacentFiles(fileOf(kingSq));
+        Bitboard front = colour == Colour::WHITE ? (RANK_1 << (8 * (rankOf(kingSq) + 1))) | (RANK_1 << (8 * (rankOf(kingSq) + 2)))
+                                                 : (RANK_1 << (8 * (rankOf(kingSq) - 1))) | (RANK_1 << (8 * (rankOf(kingSq) - 2)));
+        bonus = SHELTER_PAWN * popCount(pos.getPieces(colour, PieceType::PAWN) & files & front);
+    }
+    shelterSquare[c] = static_cast<int8_t>(kingSq);
+    shelter[c] = static_cast<int16_t>(bonus);
+    return bonus;
+}
+
+void PawnTable::clear() {
+    fill(entries.get(), entries.get() + SIZE, PawnEntry{});
+    probes = hits = 0;
+}
+
+PawnEntry &PawnTable::probe(const BitPosition &pos) {
+    ++probes;
+    PawnEntry &entry = entries[pos.getPawnKey() & (SIZE - 1)];
+    if (entry.key == pos.getPawnKey()) {
+        ++hits;
+        return entry;
+    }
+    entry.key = pos.getPawnKey();
+    evaluateStructure(pos, entry);
+    return entry;
+}
@@ -0,0 +1,40 @@
+#ifndef PAWNS_H
+#define PAWNS_H
+#include "bitPosition.h"
+#include <cstdint>
+#include <memory>
+
+// Pawn structure evaluation for one pawn key, from white's point of view. Doubled, isolated,
+// backward and passed pawns depend only on the pawns, which rarely change between neighbouring
+// nodes, so they are computed once per structure. The king shelter also depends on the king's
+// square and is cached per colour for the last square it was asked for.
+struct PawnEntry {
+    Key key = 0;
+    int midgame = 0;
+    int endgame = 0;
+    Bitboard passed[2] = {0, 0};       // passed pawns by colourIndex
+    std::int8_t shelterSquare[2] = {NO_SQUARE, NO_SQUARE};
+    std::int16_t shelter[2] = {0, 0};  // middlegame bonus for pawns in front of that king square
+
+    int kingShelter(const BitPosition &pos, Colour colour);
+};
+
+// Direct-mapped cache of pawn entries. Each search thread has its own, so no locking is needed.
+// An empty slot (key 0, all zero) is also the correct entry for a position without pawns.
+class PawnTable {
+  public:
+    static const int SIZE = 16384; // entries, a power of two; 640 KB
+
+  private:
+    std::unique_ptr<PawnEntry[]> entries;
+
+  public:
+    std::uint64_t probes = 0;
+    std::uint64_t hits = 0;
+
+    PawnTable() : entries{std::make_unique<PawnEntry[]>(SIZE)} {}
+    PawnEntry &probe(const BitPosition &pos); // computes and stores the entry on a miss
+    void clear();                             // empties every slot and the counts
+};
+
+#endif
@@ -0,0 +1,153 @@
+#include "perft.h"
+#include "board.h"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <sstream>
+
+using namespace std;
+
+uint64_t perft(BitPosition &pos, int depth) {
+    MoveList moves;
+    pos.generateLegalMoves(moves);
+    if (depth <= 1) return depth == 1 ? moves.size() : 1; // bulk count the last ply
+
+    uint64_t nodes = 0;
+    UndoInfo undo;
+    for (PackedMove mv : moves) {
+        pos.makeMove(mv, undo);
+        nodes += perft(pos, depth - 1);
+        pos.unmakeMove(mv, undo);
+    }
+    return nodes;
+}
+
+static void printSummary(uint64_t nodes, chrono::steady_clock::duration elapsed, ostream &out) {
+    double seconds = chrono::duration<double>(elapsed).count();
+    out << "Nodes: " << nodes
+        << "  Time: " << chrono::duration_cast<chrono::milliseconds>(elapsed).count() << " ms"
+        << "  NPS: " << (seconds > 0 ? static_cast<uint64_t>(nodes / seconds) : 0) << endl;
+}
+
+uint64_t perftDivide(BitPosition &pos, int depth, ostream &out) {
+    auto start = chrono::steady_clock::now();
+    MoveList moves;
+    pos.generateLegalMoves(moves);
+
+    uint64_t total = 0;
+    UndoInfo undo;
+    for (PackedMove mv : moves) {
+        pos.makeMove(mv, undo);
+        uint64_t nodes = perft(pos, depth - 1);
+        pos.unmakeMove(mv, undo);
+        out << mv << ": " << nodes << endl;
+        total += nodes;
+    }
+    out << "Moves: " << moves.size() << endl;
+    printSummary(total, chrono::steady_clock::now() - start, out);
+    return total;
+}
+
+// Board keeps each side's legal moves per square and regenerates only the squares a move can
+// affect, so the suite also walks a few plies of every position on a Board and compares both
+// spliced lists with a full generation after each make and unmake
+const int LIST_CHECK_DEPTH = 3;
+
+static bool sameMoves(span<const PackedMove> spliced, const MoveList &full) {
+    if (static_cast<int>(spliced.size()) != full.size()) return false;
+    for (PackedMove mv : spliced) {
+        if (!full.contains(mv)) return false;
+    }
+    for (PackedMove mv : full) {
+        if (find(spliced.begin(), spliced.end(), mv) == spliced.end()) return false;
+    }
+    return true;
+}
+
+static bool moveListsMatch(Board &board) {
+    for (Colour colour : {Colour::WHITE, Colour::BLACK}) {
+        BitPosition view = board.getBitPosition();
+        view.setSideToMove(colour);
+        MoveList full;
+        view.generateLegalMoves(full);
+        if (!sameMoves(colour == Colour::WHITE ? board.getWhiteMoveList() : board.getBlackMoveList(), full)) return false;
+    }
+    return true;
+}
+
+// Returns the number of positions on the walk whose lists differ
+static int checkMoveLists(Board &board, int depth, uint64_t &checks) {
+    int mismatches = 0;
+    ++checks;
+    if (!moveListsMatch(board)) ++mismatches;
+    if (depth == 0) return mismatches;
+
+    MoveList moves;
+    board.getBitPosition().generateLegalMoves(moves);
+    for (PackedMove mv : moves) {
+        board.makeMove(board.getBitPosition().unpack(mv));
+        mismatches += checkMoveLists(board, depth - 1, checks);
+        board.unmakeMove();
+        ++checks;
+        if (!moveListsMatch(board)) ++mismatches;
+    }
+    return mismatches;
+}
+
+int runPerftSuite(const string &file, ostream &out) {
+    ifstream in{file};
+    if (!in) {
+        out << "Cannot open " << file << endl;
+        return 1;
+    }
+
+    int failures = 0;
+    uint64_t totalNodes = 0;
+    chrono::steady_clock::duration perftTime{}; // the move list walks are left out of the rate
+    string line;
+    while (getline(in, line)) {
+        if (line.empty() || line[0] == '#') continue;
+
+        istringstream fields{line};
+        string fen, field;
+        getline(fields, fen, ';');
+        BitPosition pos;
+        if (!pos.setFromFEN(fen)) {
+            out << "FAIL bad FEN: " << fen << endl;
+            ++failures;
+            continue;
+        }
+
+        // Each expected count looks like "D<depth> <nodes>"
+        while (getline(fields, field, ';')) {
+            istringstream entry{field};
+            string tag;
+            uint64_t expected;
+            if (!(entry >> tag >> expected) || tag.size() < 2 || tag[0] != 'D') continue;
+            int depth = stoi(tag.substr(1));
+
+            auto start = chrono::steady_clock::now();
+            uint64_t nodes = perft(pos, depth);
+            perftTime += chrono::steady_clock::now() - start;
+            totalNodes += nodes;
+            bool ok = (nodes == expected);
+            if (!ok) ++failures;
+            out << (ok ? "ok   " : "FAIL ") << fen << " depth " << depth << ": " << nodes;
+            if (!ok) out << " (expected " << expected << ")";
+            out << endl;
+        }
+
+        Board board;
+        board.fromFEN(fen, false);
+        uint64_t checks = 0;
+        int mismatches = checkMoveLists(board, LIST_CHECK_DEPTH, checks);
+        if (mismatches) ++failures;
+        out << (mismatches ? "FAIL " : "ok   ") << fen << " move lists: " << checks << " checks";
+        if (mismatches) out << " (" << mismatches << " differ)";
+        out << endl;
+    }
+
+    printSummary(totalNodes, perftTime, out);
+    out << (failures ? "perft suite FAILED: " : "perft suite passed: ") << failures << " mismatches" << endl;
+    return failures;
+}
@@ -0,0 +1,19 @@
+#ifndef PERFT_H
+#define PERFT_H
+#include "bitPosition.h"
+#include <cstdint>
+#include <iostream>
+#include <string>
+
+// Counts the leaf nodes of the legal move tree to the given depth
+std::uint64_t perft(BitPosition &pos, int depth);
+
+// perft split by root move, then totals with elapsed time and nodes per second
+std::uint64_t perftDivide(BitPosition &pos, int depth, std::ostream &out);
+
+// Runs perft on every line of an EPD file ("<fen> ;D1 20 ;D2 400 ...") and compares the counts,
+// then checks Board's incrementally kept move lists along a short walk from each position.
+// Returns the number of mismatches (or 1 if the file cannot be read).
+int runPerftSuite(const std::string &file, std::ostream &out);
+
+#endif
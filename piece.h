@@ -10,7 +10,7 @@ class Piece {
     int moveCount = 0;
 
     public:
-    Piece(PieceType pieceType, Colour colour);
+    Piece(PieceType pieceType = PieceType::NONE, Colour colour = Colour::NONE); // default is an empty square
     PieceType getPieceType() const;
     Colour getColour() const;
     bool hasMoved();
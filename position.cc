@@ -60,43 +60,3 @@ ostream &operator<<(std::ostream &out, const Position &pos){
     cout << pos.getColChar() << pos.getRow();
     return out;
 }
-
-vector<Position> Position::getAllPositions(Position from, Position to) {
-    //Bresenham algorithm
-    // Finding all positions in between attacker (not knight) and king
-    vector<Position> positions;
-
-    int x0 = from.getColVector();
-    int y0 = from.getRowVector();
-    int x1 = to.getColVector();
-    int y1 = to.getRowVector();
-
-    int dx = abs(x1 - x0);
-    int dy = abs(y1 - y0);
-
-    int sx = (x0 < x1) ? 1 : -1;
-    int sy = (y0 < y1) ? 1 : -1;
-
-    int err = dx - dy;
-    int x = x0;
-    int y = y0;
-
-    while (!(x == x1 && y == y1)) {
-        // Move along the line
-        int e2 = 2 * err;
-        if (e2 > -dy) {
-            err -= dy;
-            x += sx;
-        }
-        if (e2 < dx) {
-            err += dx;
-            y += sy;
-        }
-
-        Position current{y, x};
-        if (!(current == from || current == to)) {
-            positions.push_back(current);
-        }
-    }    
-    return positions;
-}
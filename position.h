@@ -31,8 +31,6 @@ class Position{
     bool operator==(const Position& other) const;
 
     friend std::ostream &operator<<(std::ostream &out, const Position &pos);
-
-    static std::vector<Position> getAllPositions(Position from, Position to);
 };
 
 std::ostream &operator<<(std::ostream &out, const Position &pos);
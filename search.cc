@@ -0,0 +1,457 @@
+#include "search.h"
+#include "evaluate.h"
+#include "movePicker.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <memory>
+#include <thread>
+
+using namespace std;
+
+// Nodes between clock reads; small enough to stop within a millisecond or so
+const uint64_t TIME_CHECK_NODES = 2048;
+
+// Iterations from this depth on start with a window this many centipawns either side of the
+// previous score; shallower ones are too unstable to guess from
+const int ASPIRATION_DEPTH = 5;
+const int ASPIRATION_WINDOW = 25;
+
+// Pruning applies up to these depths; margins are in centipawns per ply of depth
+const int RFP_DEPTH = 6;
+const int RFP_MARGIN = 80;
+const int FUTILITY_DEPTH = 3;
+const int FUTILITY_MARGIN = 120;
+const int LMP_DEPTH = 4; // beyond 3 + depth^2 moves
+// Null moves from this depth, and verified from this one on
+const int NULL_MOVE_DEPTH = 3;
+const int NULL_VERIFY_DEPTH = 8;
+// Late move reductions from this depth
+const int LMR_DEPTH = 3;
+const int LMR_MOVES = 64;
+
+// Reductions grow with the log of both the remaining depth and the move number
+static const auto LMR_TABLE = [] {
+    array<array<int, LMR_MOVES>, MAX_PLY + 1> table{};
+    for (int depth = 1; depth <= MAX_PLY; ++depth) {
+        for (int move = 1; move < LMR_MOVES; ++move)
+            table[depth][move] = static_cast<int>(0.75 + log(depth) * log(move) / 2.25);
+    }
+    return table;
+}();
+
+// Names for the feature switches, in the order describe() lists them
+static const pair<const char *, bool SearchFeatures::*> FEATURE_NAMES[] = {
+    {"pvs", &SearchFeatures::pvs},
+    {"aspiration", &SearchFeatures::aspiration},
+    {"nullmove", &SearchFeatures::nullMove},
+    {"lmr", &SearchFeatures::lmr},
+    {"rfp", &SearchFeatures::rfp},
+    {"futility", &SearchFeatures::futility},
+    {"lmp", &SearchFeatures::lmp},
+};
+
+bool SearchFeatures::set(const string &name, bool on) {
+    for (const auto &[featureName, member] : FEATURE_NAMES) {
+        if (name == featureName) {
+            this->*member = on;
+            return true;
+        }
+    }
+    return false;
+}
+
+string SearchFeatures::describe() const {
+    string out;
+    for (const auto &[featureName, member] : FEATURE_NAMES) {
+        if (!out.empty()) out += ", ";
+        out += featureName;
+        out += this->*member ? " on" : " off";
+    }
+    return out;
+}
+
+PruningStats &PruningStats::operator+=(const PruningStats &other) {
+    nullMoveTries += other.nullMoveTries;
+    nullMoveCutoffs += other.nullMoveCutoffs;
+    nullMoveVerifyFails += other.nullMoveVerifyFails;
+    lmrReductions += other.lmrReductions;
+    lmrResearches += other.lmrResearches;
+    rfpCutoffs += other.rfpCutoffs;
+    futilityPrunes += other.futilityPrunes;
+    lmpPrunes += other.lmpPrunes;
+    return *this;
+}
+
+// Mate scores are stored relative to the node, not the root, so they stay right wherever the
+// position turns up again
+static int scoreToTT(int score, int ply) {
+    if (score >= MATE_SCORE - MAX_PLY) return score + ply;
+    if (score <= -MATE_SCORE + MAX_PLY) return score - ply;
+    return score;
+}
+
+static int scoreFromTT(int score, int ply) {
+    if (score >= MATE_SCORE - MAX_PLY) return score - ply;
+    if (score <= -MATE_SCORE + MAX_PLY) return score + ply;
+    return score;
+}
+
+// A position repeated since the last capture or pawn move is scored as a draw
+bool Search::Worker::isRepetition() const {
+    int reversible = min<int>(pos.getHalfmoveClock(), keys.size());
+    for (int i = 2; i <= reversible; i += 2) {
+        if (keys[keys.size() - i] == pos.getKey()) return true;
+    }
+    return false;
+}
+
+void Search::checkTime() {
+    if (limits.moveTimeMs <= 0) return;
+    auto elapsed = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start);
+    if (elapsed.count() >= limits.moveTimeMs) stopped.store(true, memory_order_relaxed);
+}
+
+int Search::Worker::negamax(int depth, int ply, int alpha, int beta) {
+    if (++nodes % TIME_CHECK_NODES == 0 && id == 0) search.checkTime();
+    if (search.stopped.load(memory_order_relaxed)) return 0;
+
+    if (ply > 0 && (pos.getHalfmoveClock() >= 100 || isRepetition())) return 0;
+
+    bool inCheck = pos.inCheck();
+    if (inCheck) ++depth; // never stop the search in check
+    if (depth <= 0) return quiescence(ply, alpha, beta);
+    if (ply >= MAX_PLY) return evaluate(pos, pawns, nnue, ply);
+
+    // A stored result searched at least as deep may settle this node outright; otherwise its
+    // move is still the best guess to try first
+    TTEntry entry;
+    PackedMove ttMove;
+    ++ttProbes;
+    if (search.tt.probe(pos.getKey(), entry)) {
+        ++ttHits;
+        ttMove = entry.move;
+        int score = scoreFromTT(entry.score, ply);
+        if (ply > 0 && entry.depth >= depth
+            && (entry.bound == Bound::EXACT
+                || (entry.bound == Bound::LOWER && score >= beta)
+                || (entry.bound == Bound::UPPER && score <= alpha)))
+            return score;
+    }
+
+    // At a PV node (open window) the first move is searched with the full window and the rest
+    // with a null window, which only has to prove them no better; one that proves better is
+    // searched again for its real score
+    bool pvNode = beta - alpha > 1;
+    bool canPrune = !pvNode && !inCheck && ply > 0; // the selective techniques stay off the PV
+    int staticEval = inCheck ? -INFINITE_SCORE : evaluate(pos, pawns, nnue, ply);
+    nullMoveAt[ply] = false;
+
+    // Reverse futility: this far above beta, no move of the opponent's is going to bring it back
+    if (canPrune && search.features.rfp && depth <= RFP_DEPTH && abs(beta) < MATE_SCORE - MAX_PLY
+        && staticEval - RFP_MARGIN * depth >= beta) {
+        ++pruning.rfpCutoffs;
+        return staticEval;
+    }
+
+    // Null move: pass, and if a shallower search still beats beta, any real move would too.
+    // That fails only in zugzwang, which needs a position with nothing but king and pawns
+    // (never tried) or a deep verification search without null moves to catch
+    if (canPrune && search.features.nullMove && depth >= NULL_MOVE_DEPTH && staticEval >= beta
+        && ply >= nullMinPly && !nullMoveAt[ply - 1] && pos.hasNonPawnMaterial(pos.getSideToMove())) {
+        int reducedDepth = depth - 1 - (3 + depth / 4);
+        ++pruning.nullMoveTries;
+        UndoInfo undo;
+        keys.push_back(pos.getKey());
+        nullMoveAt[ply] = true;
+        if (nnueVersion) nnue.recordNullMove(ply + 1);
+        pos.makeNullMove(undo);
+        int score = -negamax(reducedDepth, ply + 1, -beta, -beta + 1);
+        pos.unmakeNullMove(undo);
+        nullMoveAt[ply] = false;
+        keys.pop_back();
+        if (search.stopped.load(memory_order_relaxed)) return 0;
+
+        if (score >= beta) {
+            if (score >= MATE_SCORE - MAX_PLY) score = beta; // a mate found by passing proves nothing
+            if (depth < NULL_VERIFY_DEPTH) {
+                ++pruning.nullMoveCutoffs;
+                return score;
+            }
+            int savedMinPly = nullMinPly;
+            nullMinPly = ply + 3 * reducedDepth / 4;
+            int verified = negamax(reducedDepth, ply, beta - 1, beta);
+            nullMinPly = savedMinPly;
+            if (verified >= beta) {
+                ++pruning.nullMoveCutoffs;
+                return score;
+            }
+            ++pruning.nullMoveVerifyFails;
+        }
+    }
+
+    MovePicker picker(pos, ply == 0 && !rootBest.isNone() ? rootBest : ttMove, killers[ply], history);
+    MoveList quietsTried;
+    int moveCount = 0;
+    int originalAlpha = alpha;
+    int best = -INFINITE_SCORE;
+    PackedMove bestMove;
+    UndoInfo undo;
+    for (PackedMove mv = picker.next(); !mv.isNone(); mv = picker.next()) {
+        ++moveCount;
+        bool quiet = !mv.isCapture() && !mv.isPromotion();
+        bool givesCheck = quiet && pos.givesCheck(mv);
+
+        // Near the leaves, once one move has been searched, quiet moves late in the order or too
+        // far below alpha to matter are not searched at all
+        if (canPrune && quiet && !givesCheck && best > -MATE_SCORE + MAX_PLY) {
+            if (search.features.lmp && depth <= LMP_DEPTH && moveCount > 3 + depth * depth) {
+                ++pruning.lmpPrunes;
+                continue;
+            }
+            if (search.features.futility && depth <= FUTILITY_DEPTH && staticEval + FUTILITY_MARGIN * depth <= alpha) {
+                ++pruning.futilityPrunes;
+                continue;
+            }
+        }
+
+        // Late quiet moves are searched shallower with a null window first; only one that beats
+        // alpha there earns the full depth
+        int reduction = 0;
+        if (search.features.lmr && ply > 0 && depth >= LMR_DEPTH && moveCount > (pvNode ? 2 : 1) && quiet && !inCheck && !givesCheck) {
+            reduction = LMR_TABLE[min(depth, MAX_PLY)][min(moveCount, LMR_MOVES - 1)];
+            if (pvNode) --reduction;
+            if (mv == killers[ply][0] || mv == killers[ply][1]) --reduction;
+            reduction = clamp(reduction, 0, depth - 2);
+        }
+
+        keys.push_back(pos.getKey());
+        if (nnueVersion) nnue.recordMove(ply + 1, pos, mv);
+        pos.makeMove(mv, undo);
+        int score = alpha + 1; // a move not reduced goes straight on to the searches below
+        if (reduction > 0) {
+            ++pruning.lmrReductions;
+            score = -negamax(depth - 1 - reduction, ply + 1, -alpha - 1, -alpha);
+            if (score > alpha) ++pruning.lmrResearches;
+        }
+        if (score > alpha) {
+            if (moveCount == 1 || (pvNode && !search.features.pvs)) {
+                score = -negamax(depth - 1, ply + 1, -beta, -alpha);
+            } else {
+                score = -negamax(depth - 1, ply + 1, -alpha - 1, -alpha);
+                if (pvNode && score > alpha && score < beta) {
+                    ++pvsResearches;
+                    score = -negamax(depth - 1, ply + 1, -beta, -alpha);
+                }
+            }
+        }
+        pos.unmakeMove(mv, undo);
+        keys.pop_back();
+        if (search.stopped.load(memory_order_relaxed)) return 0;
+
+        if (score > best) {
+            best = score;
+            bestMove = mv;
+            if (ply == 0) rootBest = mv;
+        }
+        if (score > alpha) alpha = score;
+        if (alpha >= beta) {
+            ++cutoffs;
+            if (moveCount == 1) ++firstMoveCutoffs;
+            if (quiet) rewardQuiet(mv, quietsTried, depth, ply);
+            break;
+        }
+        if (quiet) quietsTried.add(mv);
+    }
+    if (moveCount == 0) return inCheck ? -MATE_SCORE + ply : 0;
+
+    Bound bound = best >= beta ? Bound::LOWER : best > originalAlpha ? Bound::EXACT : Bound::UPPER;
+    search.tt.store(pos.getKey(), bound == Bound::UPPER ? PackedMove{} : bestMove, scoreToTT(best, ply), depth, bound);
+    return best;
+}
+
+// Resolves captures and promotions at the leaves, so the static evaluation is never taken in the
+// middle of an exchange. The side to move may stand pat on the evaluation unless in check, and
+// captures that lose material by static exchange are not searched at all.
+int Search::Worker::quiescence(int ply, int alpha, int beta) {
+    if (++nodes % TIME_CHECK_NODES == 0 && id == 0) search.checkTime();
+    if (search.stopped.load(memory_order_relaxed)) return 0;
+    if (ply >= MAX_PLY) return evaluate(pos, pawns, nnue, ply);
+
+    // In check every evasion is searched (with the full picker); otherwise only captures and
+    // promotions that do not lose material
+    bool inCheck = pos.inCheck();
+    int best = -INFINITE_SCORE;
+    if (!inCheck) {
+        best = evaluate(pos, pawns, nnue, ply);
+        if (best >= beta) return best;
+        if (best > alpha) alpha = best;
+    }
+
+    const PackedMove noKillers[2] = {};
+    MovePicker picker = inCheck ? MovePicker{pos, PackedMove{}, noKillers, history} : MovePicker{pos};
+    UndoInfo undo;
+    int moveCount = 0;
+    for (PackedMove mv = picker.next(); !mv.isNone(); mv = picker.next()) {
+        ++moveCount;
+        if (nnueVersion) nnue.recordMove(ply + 1, pos, mv);
+        pos.makeMove(mv, undo);
+        int score = -quiescence(ply + 1, -beta, -alpha);
+        pos.unmakeMove(mv, undo);
+        if (search.stopped.load(memory_order_relaxed)) return 0;
+
+        if (score > best) best = score;
+        if (score > alpha) alpha = score;
+        if (alpha >= beta) break;
+    }
+    if (inCheck && moveCount == 0) return -MATE_SCORE + ply;
+    return best;
+}
+
+// A quiet move that caused a cutoff becomes a killer for this ply and gains history; the quiet
+// moves tried before it lose as much
+void Search::Worker::rewardQuiet(PackedMove mv, const MoveList &quietsTried, int depth, int ply) {
+    if (killers[ply][0] != mv) {
+        killers[ply][1] = killers[ply][0];
+        killers[ply][0] = mv;
+    }
+    int bonus = min(depth * depth, 400);
+    Colour us = pos.getSideToMove();
+    history.update(us, mv, bonus);
+    for (PackedMove tried : quietsTried) history.update(us, tried, -bonus);
+}
+
+// Helper threads skip iterations in blocks of skipSize, offset by skipPhase, so that at any time
+// they are spread over the next few depths instead of all repeating the main thread's work
+const int SKIP_PATTERNS = 20;
+const int SKIP_SIZE[SKIP_PATTERNS] = {1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 4, 4, 4, 4, 4, 4, 4, 4};
+const int SKIP_PHASE[SKIP_PATTERNS] = {0, 1, 0, 1, 2, 3, 0, 1, 2, 3, 4, 5, 0, 1, 2, 3, 4, 5, 6, 7};
+
+// One iteration at the root. Once the scores have settled the window is centred on the last
+// one; a result outside it only bounds the real score, so the window widens on that side and
+// the iteration runs again
+int Search::Worker::searchRoot(int depth, IterationStats &stats) {
+    if (!search.features.aspiration || depth < ASPIRATION_DEPTH || abs(score) >= MATE_SCORE - MAX_PLY)
+        return negamax(depth, 0, -INFINITE_SCORE, INFINITE_SCORE);
+
+    int delta = ASPIRATION_WINDOW;
+    int alpha = max(score - delta, -INFINITE_SCORE);
+    int beta = min(score + delta, INFINITE_SCORE);
+    while (true) {
+        int value = negamax(depth, 0, alpha, beta);
+        if (search.stopped.load(memory_order_relaxed)) return value;
+        if (value <= alpha) {
+            beta = (alpha + beta) / 2;
+            alpha = max(value - delta, -INFINITE_SCORE);
+        } else if (value >= beta) {
+            beta = min(value + delta, INFINITE_SCORE);
+        } else {
+            return value;
+        }
+        ++stats.aspirationResearches;
+        delta *= 2;
+    }
+}
+
+void Search::Worker::newSearch() {
+    nodes = ttProbes = ttHits = 0;
+    pawns.probes = pawns.hits = 0;
+    cutoffs = firstMoveCutoffs = pvsResearches = 0;
+    pruning = PruningStats{};
+    iterations.clear();
+    best = rootBest = PackedMove{};
+    score = completedDepth = 0;
+    // Killers are kept by ply, which means a different position once moves have been played
+    for (auto &plyKillers : killers) plyKillers[0] = plyKillers[1] = PackedMove{};
+}
+
+void Search::Worker::clear() {
+    newSearch();
+    history.clear();
+    pawns.clear();
+}
+
+void Search::Worker::run(const BitPosition &root, const vector<Key> &history) {
+    pos = root;
+    keys = history;
+    nnue.reset();
+
+    int pattern = (id - 1) % SKIP_PATTERNS;
+    for (int depth = 1; depth <= search.limits.depth; ++depth) {
+        if (id > 0 && ((depth + SKIP_PHASE[pattern]) / SKIP_SIZE[pattern]) % 2) continue;
+
+        IterationStats stats;
+        stats.depth = depth;
+        uint64_t nodesBefore = nodes, pvsBefore = pvsResearches;
+        int value = searchRoot(depth, stats);
+        stats.nodes = nodes - nodesBefore;
+        stats.pvsResearches = pvsResearches - pvsBefore;
+        if (search.stopped.load(memory_order_relaxed)) break;
+        iterations.push_back(stats);
+        best = rootBest;
+        score = value;
+        completedDepth = depth;
+        if (abs(value) >= MATE_SCORE - MAX_PLY) break; // a forced mate will not get any shorter
+    }
+
+    // The main thread's iterations decide when the search is over
+    if (id == 0) search.stopped.store(true, memory_order_relaxed);
+}
+
+Search::Search() {
+    setThreads(1);
+}
+
+void Search::setThreads(int n) {
+    workers.resize(min(workers.size(), static_cast<size_t>(n)));
+    while (static_cast<int>(workers.size()) < n) workers.push_back(make_unique<Worker>(*this, static_cast<int>(workers.size())));
+}
+
+void Search::clear() {
+    tt.clear();
+    for (auto &worker : workers) worker->clear();
+}
+
+SearchResult Search::think(const BitPosition &root, const vector<Key> &history) {
+    tt.newSearch();
+    start = chrono::steady_clock::now();
+    stopped.store(false, memory_order_relaxed);
+    for (auto &worker : workers) worker->newSearch();
+
+    SearchResult result;
+    MoveList rootMoves;
+    root.generateLegalMoves(rootMoves);
+    if (!rootMoves.empty()) {
+        vector<thread> helpers;
+        for (size_t i = 1; i < workers.size(); ++i) helpers.emplace_back(&Worker::run, workers[i].get(), cref(root), cref(history));
+        workers[0]->run(root, history);
+        for (thread &helper : helpers) helper.join();
+
+        // Report the deepest completed iteration of any thread, preferring the main thread's
+        result.best = rootMoves[0]; // in case not even depth 1 finished in time
+        const Worker *chosen = workers[0].get();
+        for (const auto &worker : workers) {
+            if (worker->completedDepth > chosen->completedDepth) chosen = worker.get();
+        }
+        if (chosen->completedDepth > 0) {
+            result.best = chosen->best;
+            result.score = chosen->score;
+            result.depth = chosen->completedDepth;
+        }
+    }
+
+    for (const auto &worker : workers) {
+        result.nodes += worker->nodes;
+        result.cutoffs += worker->cutoffs;
+        result.firstMoveCutoffs += worker->firstMoveCutoffs;
+        result.pruning += worker->pruning;
+        result.ttProbes += worker->ttProbes;
+        result.ttHits += worker->ttHits;
+        result.pawnProbes += worker->pawns.probes;
+        result.pawnHits += worker->pawns.hits;
+    }
+    result.iterations = workers[0]->iterations;
+    result.hashfull = tt.hashfull();
+    result.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    return result;
+}
@@ -0,0 +1,151 @@
+#ifndef SEARCH_H
+#define SEARCH_H
+#include "bitPosition.h"
+#include "transpositionTable.h"
+#include "movePicker.h"
+#include "nnue.h"
+#include "pawns.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Scores are centipawns from the side to move's point of view; mates count down from MATE_SCORE by ply
+const int MATE_SCORE = 32000;
+const int INFINITE_SCORE = 32001;
+const int MAX_PLY = 128;
+const int MAX_THREADS = 256;
+
+struct SearchLimits {
+    int depth = 64;        // deepest iteration to start
+    int moveTimeMs = 1000; // wall clock per move, 0 for no limit
+};
+
+// Search techniques that can be switched off to measure what each one is worth
+struct SearchFeatures {
+    bool pvs = true;        // null-window searches for every move after the first
+    bool aspiration = true; // narrow root window around the previous iteration's score
+    bool nullMove = true;   // let the opponent move twice; if we still beat beta, stop here
+    bool lmr = true;        // late move reductions: search late quiet moves shallower first
+    bool rfp = true;        // reverse futility: stop when the static eval beats beta by a margin
+    bool futility = true;   // skip quiet moves near the leaves that cannot raise alpha
+    bool lmp = true;        // late move pruning: skip the last quiet moves near the leaves
+
+    bool set(const std::string &name, bool on); // false if there is no feature called name
+    std::string describe() const;               // e.g. "pvs on, aspiration off"
+};
+
+// What one iteration of the main thread cost, and how often its windows were wrong
+struct IterationStats {
+    int depth = 0;
+    std::uint64_t nodes = 0;
+    int aspirationResearches = 0; // root searches repeated with a wider window
+    std::uint64_t pvsResearches = 0; // null-window searches that failed high and were repeated
+};
+
+// How often each pruning technique fired, summed over the threads
+struct PruningStats {
+    std::uint64_t nullMoveTries = 0;
+    std::uint64_t nullMoveCutoffs = 0;
+    std::uint64_t nullMoveVerifyFails = 0; // cutoffs the zugzwang verification search refused
+    std::uint64_t lmrReductions = 0;
+    std::uint64_t lmrResearches = 0;      // reduced searches that beat alpha and were repeated at full depth
+    std::uint64_t rfpCutoffs = 0;
+    std::uint64_t futilityPrunes = 0;
+    std::uint64_t lmpPrunes = 0;
+
+    PruningStats &operator+=(const PruningStats &other);
+};
+
+struct SearchResult {
+    PackedMove best;       // none only if the root has no legal move
+    int score = 0;
+    int depth = 0;         // deepest completed iteration
+    std::uint64_t nodes = 0;
+    double seconds = 0;
+    std::uint64_t ttProbes = 0;
+    std::uint64_t ttHits = 0;
+    int hashfull = 0;      // permill of the transposition table in use by this search
+    std::uint64_t pawnProbes = 0;
+    std::uint64_t pawnHits = 0;
+    std::uint64_t cutoffs = 0;
+    std::uint64_t firstMoveCutoffs = 0; // cutoffs by the first move tried, a measure of move ordering
+    std::vector<IterationStats> iterations; // the main thread's, shallowest first
+    PruningStats pruning;
+};
+
+// Iterative deepening negamax with alpha-beta pruning over a BitPosition.
+// The position is copied in, so the caller's Board and its cells never see the search's moves.
+// With more than one thread it runs Lazy SMP: every thread searches the same root with its own
+// position copy, and they share only the transposition table and the stop flag. Helper threads
+// skip some iterations so they spread over several depths and fill the table ahead of the main one.
+class Search {
+    // One search thread: everything a negamax call writes, so threads never share it. Workers live
+    // as long as the Search, so history and the pawn cache carry over from one move to the next
+    class Worker {
+        Search &search;
+        int id;                // 0 is the main thread, which also watches the clock
+        BitPosition pos;
+        std::vector<Key> keys; // positions before the current one: game history, then the search path
+        PackedMove rootBest;
+        PackedMove killers[MAX_PLY + 1][2] = {}; // quiet moves that recently caused cutoffs, per ply
+        ButterflyHistory history;
+        NnueStack nnue{MAX_PLY + 1};       // network sums per ply of the current path, while a network is loaded
+        bool nullMoveAt[MAX_PLY + 1] = {}; // whether the move made at each ply of the current path was a pass
+        int nullMinPly = 0;                // no null moves before this ply, while verifying a null-move cutoff
+
+        int searchRoot(int depth, IterationStats &stats);
+        int negamax(int depth, int ply, int alpha, int beta);
+        int quiescence(int ply, int alpha, int beta);
+        void rewardQuiet(PackedMove mv, const MoveList &quietsTried, int depth, int ply);
+        bool isRepetition() const;
+
+      public:
+        std::uint64_t nodes = 0;
+        std::uint64_t ttProbes = 0;
+        std::uint64_t ttHits = 0;
+        PawnTable pawns;       // this thread's pawn structure cache, with its own probe and hit counts
+        std::uint64_t cutoffs = 0;
+        std::uint64_t firstMoveCutoffs = 0;
+        std::uint64_t pvsResearches = 0;
+        PruningStats pruning;
+        std::vector<IterationStats> iterations;
+        // Result of the deepest iteration this thread completed
+        PackedMove best;
+        int score = 0;
+        int completedDepth = 0;
+
+        Worker(Search &search, int id) : search{search}, id{id} {}
+        void newSearch();  // resets the counters, result and killers; keeps history and pawns
+        void clear();      // also forgets history and the pawn cache
+        void run(const BitPosition &root, const std::vector<Key> &history);
+    };
+
+    SearchLimits limits;
+    SearchFeatures features;
+    std::vector<std::unique_ptr<Worker>> workers; // one per thread, workers[0] the main one
+    TranspositionTable tt; // kept between moves, so each search starts from what the last one learned
+    std::chrono::steady_clock::time_point start;
+    std::atomic<bool> stopped{false};
+
+    void checkTime();
+
+  public:
+    void setLimits(const SearchLimits &newLimits) { limits = newLimits; }
+    const SearchLimits &getLimits() const { return limits; }
+    void setFeatures(const SearchFeatures &newFeatures) { features = newFeatures; }
+    const SearchFeatures &getFeatures() const { return features; }
+    void setHashSize(std::size_t mb) { tt.resize(mb); }
+    std::size_t getHashSize() const { return tt.getSizeMB(); }
+    Search();
+    void setThreads(int n); // keeps the workers already there
+    int getThreads() const { return static_cast<int>(workers.size()); }
+    void clear();           // forgets everything learned: the table, history and pawn caches
+
+    // history holds the keys of the positions played before root, oldest first
+    SearchResult think(const BitPosition &root, const std::vector<Key> &history);
+};
+
+#endif
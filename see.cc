@@ -0,0 +1,71 @@
+#include "see.h"
+#include "evaluate.h"
+
+using namespace std;
+
+// Capture order for the least valuable attacker
+const PieceType ATTACKER_ORDER[6] = {PieceType::PAWN, PieceType::KNIGHT, PieceType::BISHOP,
+                                     PieceType::ROOK, PieceType::QUEEN, PieceType::KING};
+
+int see(const BitPosition &pos, PackedMove mv) {
+    int from = mv.getFrom();
+    int to = mv.getTo();
+    if (mv.isCastle()) return 0;
+
+    // gain[d] is what the side making capture d has won if the exchange stops after it
+    int gain[32];
+    int d = 0;
+    PieceType captured = mv.isEnPassant() ? PieceType::PAWN : pos.pieceTypeOn(to);
+    PieceType onSquare = pos.pieceTypeOn(from); // the piece the next capture would take
+    gain[0] = captured == PieceType::NONE ? 0 : PIECE_VALUES[pieceIndex(captured)];
+    if (mv.isPromotion()) {
+        onSquare = mv.getPromotion();
+        gain[0] += PIECE_VALUES[pieceIndex(onSquare)] - PIECE_VALUES[pieceIndex(PieceType::PAWN)];
+    }
+
+    Bitboard occ = pos.getOccupied() ^ squareBB(from);
+    if (mv.isEnPassant()) occ ^= squareBB(to + (pos.getSideToMove() == Colour::WHITE ? -8 : 8));
+    Bitboard rooks = pos.getPieces(Colour::WHITE, PieceType::ROOK) | pos.getPieces(Colour::BLACK, PieceType::ROOK)
+                   | pos.getPieces(Colour::WHITE, PieceType::QUEEN) | pos.getPieces(Colour::BLACK, PieceType::QUEEN);
+    Bitboard bishops = pos.getPieces(Colour::WHITE, PieceType::BISHOP) | pos.getPieces(Colour::BLACK, PieceType::BISHOP)
+                     | pos.getPieces(Colour::WHITE, PieceType::QUEEN) | pos.getPieces(Colour::BLACK, PieceType::QUEEN);
+    Bitboard attackers = pos.attackersTo(to, occ) & occ;
+    Colour side = opposite(pos.getSideToMove());
+
+    while (true) {
+        Bitboard ours = attackers & pos.getOccupancy(side);
+        if (!ours) break;
+
+        PieceType attacker = PieceType::KING;
+        Bitboard candidates = 0;
+        for (PieceType pt : ATTACKER_ORDER) {
+            candidates = ours & pos.getPieces(side, pt);
+            if (candidates) {
+                attacker = pt;
+                break;
+            }
+        }
+        // The king may only take last, when nothing can take it back
+        if (attacker == PieceType::KING && (attackers & pos.getOccupancy(opposite(side)))) break;
+
+        ++d;
+        gain[d] = PIECE_VALUES[pieceIndex(onSquare)] - gain[d - 1];
+        onSquare = attacker;
+
+        // Lift the attacker and let any slider behind it join in
+        occ ^= candidates & -candidates;
+        if (attacker == PieceType::PAWN || attacker == PieceType::BISHOP || attacker == PieceType::QUEEN)
+            attackers |= bishopAttacks(to, occ) & bishops;
+        if (attacker == PieceType::ROOK || attacker == PieceType::QUEEN)
+            attackers |= rookAttacks(to, occ) & rooks;
+        attackers &= occ;
+        side = opposite(side);
+    }
+
+    // Each side may also decline to recapture
+    while (d > 0) {
+        gain[d - 1] = -max(-gain[d - 1], gain[d]);
+        --d;
+    }
+    return gain[0];
+}
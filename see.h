@@ -0,0 +1,10 @@
+#ifndef SEE_H
+#define SEE_H
+#include "bitPosition.h"
+
+// Static exchange evaluation: the material mv wins (or loses, if negative) once both sides have
+// recaptured on its target square with their least valuable attackers for as long as it pays.
+// Works on the attack tables alone, without making any move; pins are not taken into account.
+int see(const BitPosition &pos, PackedMove mv);
+
+#endif
@@ -1,5 +1,5 @@
 #include "textDisplay.h"
-#include "subject.h"
+#include "bitboard.h"
 #include <iostream>
 
 using namespace std;
@@ -10,14 +10,14 @@ TextDisplay::TextDisplay(size_t n)
     theDisplay.resize(n, vector<char>(n, '-'));
 }
 
-// Updates the display when a Cell notifies this observer
-void TextDisplay::notify(Subject &whoNotified){
-    Info info = whoNotified.getInfo();
-    Position position = info.getPosition();
-    PieceType pieceType = info.getPieceType();
-    Colour colour = info.getColour();
+// Updates the display when Board reports a square's new occupant
+void TextDisplay::notify(int sq, Piece piece){
+    int row = rankOf(sq);
+    int column = fileOf(sq);
+    PieceType pieceType = piece.getPieceType();
+    Colour colour = piece.getColour();
 
-    char symbol;
+    char symbol = ' ';
     switch(pieceType){
         case PieceType::KING :
             symbol = 'K';
@@ -38,7 +38,7 @@ void TextDisplay::notify(Subject &whoNotified){
             symbol = 'P';
             break;
         case PieceType::NONE :
-            if ((position.getRow() + position.getColVector()) % 2 == 0)
+            if ((row + 1 + column) % 2 == 0)
                 symbol = ' ';
             else
                 symbol = '_';
@@ -49,7 +49,7 @@ void TextDisplay::notify(Subject &whoNotified){
         symbol = colour == Colour::BLACK ? symbol + ('a' - 'A') : symbol;
     }
 
-    theDisplay[position.getRowVector()][position.getColVector()] = symbol;
+    theDisplay[row][column] = symbol;
 }
 
 // Outputs the board row by row
@@ -2,16 +2,15 @@
 #define TEXTDISPLAY_H
 #include <iostream>
 #include <vector>
-#include "observer.h"
-#include "info.h"
+#include "piece.h"
 
-class TextDisplay: public Observer {
+class TextDisplay {
     std::vector<std::vector<char>> theDisplay;
-    const std::size_t gridSize;
+    std::size_t gridSize;
     
   public:
     TextDisplay(std::size_t n);
-    void notify(Subject &whoNotified) override;
+    void notify(int sq, Piece piece); // what is on one square now
 
     friend std::ostream &operator<<(std::ostream &out, const TextDisplay &td);
 };
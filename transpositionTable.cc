@@ -0,0 +1,121 @@
+#include "transpositionTable.h"
+
+using namespace std;
+
+// Data word layout: move (16 bits), score (16), depth (8), bound (2), generation (6)
+static uint64_t pack(PackedMove move, int score, int depth, Bound bound, uint8_t generation) {
+    return uint64_t{move.raw()}
+         | uint64_t{static_cast<uint16_t>(score)} << 16
+         | uint64_t{static_cast<uint8_t>(depth)} << 32
+         | uint64_t{static_cast<uint8_t>(bound)} << 40
+         | uint64_t{generation} << 42;
+}
+
+static PackedMove moveOf(uint64_t data) {
+    uint16_t raw = data & 0xFFFF;
+    return raw ? PackedMove{raw & 0x3F, (raw >> 6) & 0x3F, raw >> 12} : PackedMove{};
+}
+static int depthOf(uint64_t data) { return (data >> 32) & 0xFF; }
+static uint8_t generationOf(uint64_t data) { return (data >> 42) & 0x3F; }
+
+TranspositionTable::TranspositionTable(size_t mb) {
+    resize(mb);
+}
+
+void TranspositionTable::resize(size_t mb) {
+    size_t count = max<size_t>(mb * 1024 * 1024 / sizeof(Bucket), 1);
+    unique_ptr<Bucket[]> fresh = make_unique<Bucket[]>(count); // the old table stays if this throws
+    buckets = move(fresh);
+    bucketCount = count;
+    sizeMB = mb;
+    generation = 0;
+}
+
+void TranspositionTable::clear() {
+    for (size_t i = 0; i < bucketCount; ++i) {
+        for (auto &word : buckets[i].words) word.store(0, memory_order_relaxed);
+    }
+    generation = 0;
+}
+
+void TranspositionTable::newSearch() {
+    generation = (generation + 1) & 0x3F;
+}
+
+// Maps the key onto any bucket count with a multiply instead of a modulo
+TranspositionTable::Bucket &TranspositionTable::bucketFor(Key key) const {
+    return buckets[static_cast<size_t>((static_cast<unsigned __int128>(key) * bucketCount) >> 64)];
+}
+
+bool TranspositionTable::probe(Key key, TTEntry &entry) const {
+    const Bucket &bucket = bucketFor(key);
+    for (int i = 0; i < BUCKET_ENTRIES; ++i) {
+        uint64_t check = bucket.words[2 * i].load(memory_order_relaxed);
+        uint64_t data = bucket.words[2 * i + 1].load(memory_order_relaxed);
+        if (data == 0 || (check ^ data) != key) continue;
+
+        entry.move = moveOf(data);
+        entry.score = static_cast<int16_t>((data >> 16) & 0xFFFF);
+        entry.depth = depthOf(data);
+        entry.bound = static_cast<Bound>((data >> 40) & 0x3);
+        return true;
+    }
+    return false;
+}
+
+void TranspositionTable::store(Key key, PackedMove move, int score, int depth, Bound bound) {
+    Bucket &bucket = bucketFor(key);
+
+    // Overwrite this position's own entry, keeping its move if the new result has none. A much
+    // shallower result from this search does not replace a deeper one unless it is exact; then
+    // only a new move is taken, since it is the one the latest search preferred
+    int slot = -1;
+    for (int i = 0; i < BUCKET_ENTRIES; ++i) {
+        uint64_t data = bucket.words[2 * i + 1].load(memory_order_relaxed);
+        if (data != 0 && (bucket.words[2 * i].load(memory_order_relaxed) ^ data) == key) {
+            if (move.isNone()) move = moveOf(data);
+            if (bound != Bound::EXACT && generationOf(data) == generation && depth < depthOf(data) - REPLACE_MARGIN) {
+                if (move.raw() == (data & 0xFFFF)) return;
+                data = (data & ~uint64_t{0xFFFF}) | move.raw();
+                bucket.words[2 * i].store(key ^ data, memory_order_relaxed);
+                bucket.words[2 * i + 1].store(data, memory_order_relaxed);
+                return;
+            }
+            slot = i;
+            break;
+        }
+    }
+
+    // Otherwise replace the least valuable depth-preferred entry, where every search of age
+    // costs as much as eight plies of depth, or fall back on the always-replace slot
+    if (slot < 0) {
+        int worst = INT32_MAX;
+        for (int i = 0; i < DEPTH_PREFERRED; ++i) {
+            uint64_t data = bucket.words[2 * i + 1].load(memory_order_relaxed);
+            int age = (generation - generationOf(data)) & 0x3F;
+            int value = data == 0 ? INT32_MIN : depthOf(data) - 8 * age;
+            if (value < worst) {
+                worst = value;
+                slot = i;
+            }
+        }
+        uint64_t victim = bucket.words[2 * slot + 1].load(memory_order_relaxed);
+        if (victim != 0 && generationOf(victim) == generation && depth < depthOf(victim)) slot = DEPTH_PREFERRED;
+    }
+
+    uint64_t data = pack(move, score, depth, bound, generation);
+    bucket.words[2 * slot].store(key ^ data, memory_order_relaxed);
+    bucket.words[2 * slot + 1].store(data, memory_order_relaxed);
+}
+
+int TranspositionTable::hashfull() const {
+    const size_t sampled = min<size_t>(1000 / BUCKET_ENTRIES, bucketCount);
+    int used = 0;
+    for (size_t i = 0; i < sampled; ++i) {
+        for (int j = 0; j < BUCKET_ENTRIES; ++j) {
+            uint64_t data = buckets[i].words[2 * j + 1].load(memory_order_relaxed);
+            if (data != 0 && generationOf(data) == generation) ++used;
+        }
+    }
+    return static_cast<int>(used * 1000 / (sampled * BUCKET_ENTRIES));
+}
@@ -0,0 +1,58 @@
+#ifndef TRANSPOSITIONTABLE_H
+#define TRANSPOSITIONTABLE_H
+#include "packedMove.h"
+#include "zobrist.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+// Which side of the true score a stored score lies on
+enum class Bound : std::uint8_t { NONE, UPPER, LOWER, EXACT };
+
+// A decoded table entry
+struct TTEntry {
+    PackedMove move;
+    int score;
+    int depth;
+    Bound bound;
+};
+
+// Hash table of search results keyed by Zobrist key. Each 64-byte bucket fills one cache line
+// with four entries: three kept by depth (shallow and stale entries go first) and one that is
+// always overwritten. Entries are two relaxed atomic words, the key XORed with the data and the
+// data itself, so concurrent readers and writers need no locks: a torn entry fails the XOR check
+// on probe and reads as a miss.
+class TranspositionTable {
+  public:
+    static const int BUCKET_ENTRIES = 4;
+    static const int DEPTH_PREFERRED = 3; // the last entry of a bucket is the always-replace slot
+    static const int REPLACE_MARGIN = 3;  // plies shallower than a same-search entry a result may be and still replace it
+
+  private:
+    struct alignas(64) Bucket {
+        std::atomic<std::uint64_t> words[2 * BUCKET_ENTRIES]; // per entry: key ^ data, data
+    };
+    static_assert(sizeof(Bucket) == 64, "a bucket should fill exactly one cache line");
+
+    std::unique_ptr<Bucket[]> buckets;
+    std::size_t bucketCount = 0;
+    std::size_t sizeMB = 0;
+    std::uint8_t generation = 0; // 6 bits, bumped once per search so old entries can be told apart
+
+    Bucket &bucketFor(Key key) const;
+
+  public:
+    explicit TranspositionTable(std::size_t mb = 16);
+    void resize(std::size_t mb); // also clears; throws std::bad_alloc, table unchanged, if mb cannot be allocated
+    void clear();
+    void newSearch();
+
+    bool probe(Key key, TTEntry &entry) const;
+    void store(Key key, PackedMove move, int score, int depth, Bound bound);
+
+    int hashfull() const; // permill of sampled entries written during the current search
+    std::size_t getSizeMB() const { return sizeMB; }
+};
+
+#endif
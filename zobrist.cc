@@ -0,0 +1,26 @@
+#include "zobrist.h"
+
+using namespace std;
+
+ZobristKeys zobrist;
+
+// splitmix64; a fixed seed keeps keys identical between runs, so hashes can be stored and compared
+static Key nextKey(Key &state) {
+    Key z = (state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+void initZobrist() {
+    Key state = 0x2545F4914F6CDD1DULL;
+
+    for (int c = 0; c < 2; ++c) {
+        for (int pt = 0; pt < 6; ++pt) {
+            for (int sq = 0; sq < NUM_SQUARES; ++sq) zobrist.pieces[c][pt][sq] = nextKey(state);
+        }
+    }
+    for (int rights = 0; rights < 16; ++rights) zobrist.castling[rights] = nextKey(state);
+    for (int file = 0; file < 8; ++file) zobrist.epFile[file] = nextKey(state);
+    zobrist.sideToMove = nextKey(state);
+}
@@ -0,0 +1,20 @@
+#ifndef ZOBRIST_H
+#define ZOBRIST_H
+#include "bitboard.h"
+#include <cstdint>
+
+// Random keys XORed together to give every position a 64-bit identity
+using Key = std::uint64_t;
+
+struct ZobristKeys {
+    Key pieces[2][6][NUM_SQUARES];
+    Key castling[16];   // indexed by the castling rights mask
+    Key epFile[8];      // only hashed when an en passant capture is possible
+    Key sideToMove;     // XORed in when black is to move
+};
+
+extern ZobristKeys zobrist;
+
+void initZobrist(); // must be called once before any position is hashed
+
+#endif